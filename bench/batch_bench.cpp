@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "batch.hpp"
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view record_format = "{%u},{%d},{%f},{}";
+
+std::string make_records(std::size_t count) {
+    std::string buffer;
+    for(std::size_t i = 0; i < count; ++i) {
+        buffer += std::to_string(i) + "," + std::to_string(static_cast<int>(i % 2000) - 1000) + "," +
+                  std::to_string(i % 977) + ".125,sym" + std::to_string(i % 50) + "\n";
+    }
+    return buffer;
+}
+
+// Построчный scan с последующим транспонированием кортежей в колонки.
+void BM_ScanPerLineThenTranspose(benchmark::State& state) {
+    const auto buffer = make_records(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state) {
+        std::vector<unsigned int> ids;
+        std::vector<int> deltas;
+        std::vector<double> prices;
+        std::vector<std::string_view> symbols;
+        std::string_view rest = buffer;
+        while(!rest.empty()) {
+            auto end  = rest.find('\n');
+            auto line = rest.substr(0, end);
+            rest      = end == std::string_view::npos ? std::string_view {} : rest.substr(end + 1);
+            if(auto result = stdx::scan<unsigned int, int, double, std::string_view>(line, record_format)) {
+                auto& [id, delta, price, symbol] = result->result;
+                ids.push_back(id);
+                deltas.push_back(delta);
+                prices.push_back(price);
+                symbols.push_back(symbol);
+            }
+        }
+        benchmark::DoNotOptimize(ids.data());
+        benchmark::DoNotOptimize(symbols.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_ScanPerLineThenTranspose)->Arg(1 << 16);
+
+// Пакетное сканирование сразу в колонки.
+void BM_ScanBatchColumns(benchmark::State& state) {
+    const auto buffer = make_records(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state) {
+        auto batch = stdx::scan_batch<unsigned int, int, double, std::string_view>(buffer, record_format);
+        benchmark::DoNotOptimize(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_ScanBatchColumns)->Arg(1 << 16);
+
+}  // namespace
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+
+#include "cache.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Формат приходит во время выполнения, например из конфигурации, поэтому хранится в std::string.
+const std::string runtime_format = "[{%u}] {%s} id={%d} took {%f} ms";
+constexpr std::string_view line  = "[1700000000] GET id=4242 took 12.25 ms";
+
+// Разбор формата на каждом вызове.
+void BM_RuntimeFormatScan(benchmark::State& state) {
+    for(auto _ : state) {
+        auto result = stdx::scan<unsigned, std::string_view, int, double>(line, runtime_format);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_RuntimeFormatScan)->ThreadRange(1, 4);
+
+// Кэш скомпилированных шаблонов.
+void BM_RuntimeFormatCached(benchmark::State& state) {
+    for(auto _ : state) {
+        auto result = stdx::scan_cached<unsigned, std::string_view, int, double>(line, runtime_format);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_RuntimeFormatCached)->ThreadRange(1, 4);
+
+// Шаблон, скомпилированный и сохранённый вызывающим кодом: нижняя граница для кэша.
+void BM_RuntimeFormatPattern(benchmark::State& state) {
+    const auto pattern = stdx::scan_pattern<unsigned, std::string_view, int, double>::compile(runtime_format).value();
+    for(auto _ : state) {
+        auto result = pattern.scan(line);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_RuntimeFormatPattern)->ThreadRange(1, 4);
+
+}  // namespace
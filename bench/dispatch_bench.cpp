@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "dispatch.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Формат с номером i: у всех форматов одинаковые типы полей, а различаются они ведущим литералом.
+std::string event_format(std::size_t i) {
+    return "event" + std::to_string(i) + " id={%d} took {%f} ms";
+}
+
+// Строки, равномерно распределённые по formats форматам.
+std::vector<std::string> event_lines(std::size_t formats) {
+    std::vector<std::string> lines;
+    for(std::size_t i = 0; i < 1024; ++i) {
+        lines.push_back("event" + std::to_string(i % formats) + " id=" + std::to_string(i) + " took 12.5 ms");
+    }
+    return lines;
+}
+
+// Последовательная проба: stdx::scan с каждым форматом по очереди до первого успеха.
+void BM_DispatchSequentialScan(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> formats;
+    for(std::size_t i = 0; i < count; ++i) {
+        formats.push_back(event_format(i));
+    }
+    const auto lines = event_lines(count);
+    for(auto _ : state) {
+        for(const auto& line : lines) {
+            for(const auto& format : formats) {
+                if(auto result = stdx::scan<int, double>(line, format)) {
+                    benchmark::DoNotOptimize(result);
+                    break;
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_DispatchSequentialScan)->RangeMultiplier(2)->Range(1, 64);
+
+// Последовательная проба заранее скомпилированных шаблонов.
+void BM_DispatchSequentialPattern(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<stdx::scan_pattern<int, double>> patterns;
+    for(std::size_t i = 0; i < count; ++i) {
+        patterns.push_back(stdx::scan_pattern<int, double>::compile(event_format(i)).value());
+    }
+    const auto lines = event_lines(count);
+    for(auto _ : state) {
+        for(const auto& line : lines) {
+            for(const auto& pattern : patterns) {
+                if(auto result = pattern.scan(line)) {
+                    benchmark::DoNotOptimize(result);
+                    break;
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_DispatchSequentialPattern)->RangeMultiplier(2)->Range(1, 64);
+
+// Диспетчер с префиксным деревом по ведущим литералам.
+void BM_DispatchTrie(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    stdx::scan_dispatcher dispatcher;
+    int sum = 0;
+    for(std::size_t i = 0; i < count; ++i) {
+        (void)dispatcher.add<int, double>(event_format(i), [&](int id, double) { sum += id; });
+    }
+    const auto lines = event_lines(count);
+    for(auto _ : state) {
+        for(const auto& line : lines) {
+            benchmark::DoNotOptimize(dispatcher.dispatch(line));
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_DispatchTrie)->RangeMultiplier(2)->Range(1, 64);
+
+}  // namespace
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+#include "erased.hpp"
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view record_format = "id={%u} user={%s} delta={%d} price={%f} tag={}";
+constexpr std::string_view record_line   = "id=1234 user=alice delta=-17 price=1050.25 tag=EUR";
+
+// Полностью шаблонный путь: разбор и конверсия встраиваются в код сигнатуры.
+void BM_TemplatedScan(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(
+            stdx::scan<unsigned, std::string_view, int, double, std::string_view>(record_line, record_format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(record_line.size()));
+}
+BENCHMARK(BM_TemplatedScan);
+
+// Компактный путь: конверсия каждого поля - косвенный вызов через таблицу.
+void BM_ErasedScan(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(
+            stdx::scan_compact<unsigned, std::string_view, int, double, std::string_view>(record_line, record_format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(record_line.size()));
+}
+BENCHMARK(BM_ErasedScan);
+
+// Ошибка конверсии в середине записи: тот же отчёт об ошибке в обоих путях.
+constexpr std::string_view broken_line = "id=1234 user=alice delta=?17 price=1050.25 tag=EUR";
+
+void BM_TemplatedScanError(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(
+            stdx::scan<unsigned, std::string_view, int, double, std::string_view>(broken_line, record_format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(broken_line.size()));
+}
+BENCHMARK(BM_TemplatedScanError);
+
+void BM_ErasedScanError(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(
+            stdx::scan_compact<unsigned, std::string_view, int, double, std::string_view>(broken_line, record_format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(broken_line.size()));
+}
+BENCHMARK(BM_ErasedScanError);
+
+}  // namespace
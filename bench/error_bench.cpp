@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pattern.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Поток строк, из которых формату access-лога соответствует лишь каждая match_every-я, а остальные не совпадают
+// либо по литералам, либо по значению поля.
+std::vector<std::string> mostly_failing_lines(std::size_t match_every) {
+    std::mt19937 rng {5};
+    std::vector<std::string> lines(4096);
+    for(std::size_t i = 0; i < lines.size(); ++i) {
+        const auto id = std::to_string(rng() % 100000);
+        if(i % match_every == 0) {
+            lines[i] = "GET /item/" + id + " status=200 bytes=" + std::to_string(rng() % 5000);
+        }
+        else if(i % 2 == 0) {
+            lines[i] = "DEBUG worker-" + id + " heartbeat ok";
+        }
+        else {
+            lines[i] = "GET /item/" + id + " status=??? bytes=-";
+        }
+    }
+    return lines;
+}
+
+// Сканирование потока, в котором совпадает лишь около 5% строк; ошибки не читаются.
+void BM_MostlyFailingPattern(benchmark::State& state) {
+    const auto pattern =
+        stdx::scan_pattern<std::string_view, int, unsigned>::compile("GET {} status={%d} bytes={%u}").value();
+    const auto lines = mostly_failing_lines(20);
+    for(auto _ : state) {
+        std::size_t matched = 0;
+        for(const auto& line : lines) {
+            matched += pattern.scan(line).has_value();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_MostlyFailingPattern);
+
+// То же через scan с форматной строкой, разбираемой на каждой строке.
+void BM_MostlyFailingScan(benchmark::State& state) {
+    const auto lines = mostly_failing_lines(20);
+    for(auto _ : state) {
+        std::size_t matched = 0;
+        for(const auto& line : lines) {
+            matched +=
+                stdx::scan<std::string_view, int, unsigned>(line, "GET {} status={%d} bytes={%u}").has_value();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_MostlyFailingScan);
+
+// Стоимость построения текста ошибки, когда он всё-таки нужен.
+void BM_ErrorMessage(benchmark::State& state) {
+    const auto error = stdx::scan<int>("x", "{%d}").error();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(error.message());
+    }
+}
+BENCHMARK(BM_ErrorMessage);
+
+}  // namespace
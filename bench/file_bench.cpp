@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "file.hpp"
+
+namespace {
+
+// Сгенерированный лог-файл размером SCAN_BENCH_FILE_MB мегабайт (по умолчанию 2 ГБ), удаляемый при выходе.
+struct generated_log {
+    generated_log() :
+        path(std::filesystem::temp_directory_path() / ("scan_bench_" + std::to_string(::getpid()) + ".log")) {
+        std::size_t megabytes = 2048;
+        if(const char* env = std::getenv("SCAN_BENCH_FILE_MB")) {
+            megabytes = std::strtoull(env, nullptr, 10);
+        }
+
+        std::ofstream out(path, std::ios::binary);
+        std::string chunk;
+        std::size_t written = 0;
+        for(std::size_t i = 0; written < megabytes * 1024 * 1024; ++i) {
+            chunk.clear();
+            chunk += "[" + std::to_string(1'700'000'000 + i) + "] GET /api/v1/items id=" + std::to_string(i % 100'000) +
+                     " took " + std::to_string(i % 1000) + ".5 ms\n";
+            out << chunk;
+            written += chunk.size();
+        }
+        size = written;
+    }
+
+    ~generated_log() {
+        std::filesystem::remove(path);
+    }
+
+    std::filesystem::path path;
+    std::size_t size = 0;
+};
+
+const generated_log& log_file() {
+    static const generated_log file;
+    return file;
+}
+
+// Пропускная способность построчного сканирования отображённого в память файла.
+void BM_ScanFileThroughput(benchmark::State& state) {
+    const auto& file = log_file();
+    for(auto _ : state) {
+        auto lines =
+            stdx::scan_file<unsigned int, std::string_view, int, double>(file.path, "[{%u}] {} id={%d} took {%f} ms");
+        std::size_t matched = 0;
+        for(const auto& line : lines.value()) {
+            matched += line.has_value();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(file.size));
+}
+BENCHMARK(BM_ScanFileThroughput)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+#include "scan.hpp"
+
+namespace {
+
+// Одна и та же запись в позиционном виде и с разделителями.
+constexpr std::string_view fixed_format  = "{%8u}{%12s}{%4d}{%10f}{%10f}{%8s}";
+constexpr std::string_view fixed_line    = "00001234ACME CORP    -17   1050.25     0.125EUR     ";
+constexpr std::string_view spaced_format = "{%u} {%s} {%d} {%f} {%f} {%s}";
+constexpr std::string_view spaced_line   = "00001234 ACME_CORP -17 1050.25 0.125 EUR";
+
+using record_pattern = stdx::scan_pattern<unsigned, std::string_view, int, double, double, std::string_view>;
+
+// Позиционная запись: поля вырезаются по смещениям, известным после разбора формата.
+void BM_FixedWidthPattern(benchmark::State& state) {
+    const auto pattern = record_pattern::compile(fixed_format).value();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.scan(fixed_line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fixed_line.size()));
+}
+BENCHMARK(BM_FixedWidthPattern);
+
+// Та же запись с разделителями: границы полей ищутся по литералам.
+void BM_DelimitedPattern(benchmark::State& state) {
+    const auto pattern = record_pattern::compile(spaced_format).value();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.scan(spaced_line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(spaced_line.size()));
+}
+BENCHMARK(BM_DelimitedPattern);
+
+// Runtime-формат фиксированной ширины без предварительной компиляции.
+void BM_FixedWidthScan(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(
+            stdx::scan<unsigned, std::string_view, int, double, double, std::string_view>(fixed_line, fixed_format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fixed_line.size()));
+}
+BENCHMARK(BM_FixedWidthScan);
+
+}  // namespace
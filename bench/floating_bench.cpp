@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "decimal.hpp"
+#include "pattern.hpp"
+
+namespace {
+
+// Набор цен с четырьмя знаками после точки, как в котировках.
+const std::vector<std::string>& prices() {
+    static const std::vector<std::string> values = [] {
+        std::mt19937_64 rng {17};
+        std::vector<std::string> result(1024);
+        for(auto& value : result) {
+            value = std::to_string(rng() % 100000) + "." + std::to_string(1000 + rng() % 9000);
+        }
+        return result;
+    }();
+    return values;
+}
+
+// Прежний путь для float: разбор в double и приведение.
+void BM_FloatViaDouble(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& text : prices()) {
+            double parsed = 0;
+            std::from_chars(text.data(), text.data() + text.size(), parsed);
+            benchmark::DoNotOptimize(static_cast<float>(parsed));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices().size()));
+}
+BENCHMARK(BM_FloatViaDouble);
+
+// Разбор сразу во float.
+void BM_FloatDirect(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& text : prices()) {
+            float parsed = 0;
+            std::from_chars(text.data(), text.data() + text.size(), parsed);
+            benchmark::DoNotOptimize(parsed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices().size()));
+}
+BENCHMARK(BM_FloatDirect);
+
+// Прежний путь для цен: разбор в double и масштабирование в целое число десятитысячных.
+void BM_DecimalViaDouble(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& text : prices()) {
+            double parsed = 0;
+            std::from_chars(text.data(), text.data() + text.size(), parsed);
+            benchmark::DoNotOptimize(static_cast<std::int64_t>(std::llround(parsed * 10000)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices().size()));
+}
+BENCHMARK(BM_DecimalViaDouble);
+
+// Разбор прямо в stdx::decimal<int64_t, 4>.
+void BM_DecimalDirect(benchmark::State& state) {
+    for(auto _ : state) {
+        for(const auto& text : prices()) {
+            stdx::decimal<std::int64_t, 4> parsed;
+            stdx::details::parse_decimal(text.data(), text.data() + text.size(), parsed);
+            benchmark::DoNotOptimize(parsed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices().size()));
+}
+BENCHMARK(BM_DecimalDirect);
+
+// Сканирование строки котировки с ценами в float и в decimal.
+template<typename Price> void BM_ScanQuote(benchmark::State& state) {
+    const auto pattern     = stdx::scan_pattern<std::string_view, Price, Price>::compile("{} bid={} ask={}").value();
+    const std::string line = "AAPL bid=187.2500 ask=187.2651";
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.scan(line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_ScanQuote<float>);
+BENCHMARK(BM_ScanQuote<double>);
+BENCHMARK(BM_ScanQuote<stdx::decimal<std::int64_t, 4>>);
+
+}  // namespace
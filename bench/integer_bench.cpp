@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "integer.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Набор десятичных чисел ровно из digits цифр, разделённых пробелами.
+std::vector<std::string> numbers_with_digits(std::size_t digits) {
+    std::mt19937_64 rng {digits};
+    std::vector<std::string> numbers(1024);
+    for(auto& number : numbers) {
+        number = std::to_string(1 + rng() % 9);
+        while(number.size() < digits) {
+            number += static_cast<char>('0' + rng() % 10);
+        }
+    }
+    return numbers;
+}
+
+// Разбор чисел заданной длины через std::from_chars.
+void BM_IntegerFromChars(benchmark::State& state) {
+    const auto numbers = numbers_with_digits(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state) {
+        for(const auto& number : numbers) {
+            std::uint64_t value = 0;
+            std::from_chars(number.data(), number.data() + number.size(), value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+}
+BENCHMARK(BM_IntegerFromChars)->DenseRange(1, 10)->Arg(16)->Arg(19);
+
+// Разбор тех же чисел SWAR-ядром parse_integer.
+void BM_IntegerSwar(benchmark::State& state) {
+    const auto numbers = numbers_with_digits(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state) {
+        for(const auto& number : numbers) {
+            std::uint64_t value = 0;
+            stdx::details::parse_integer(number.data(), number.data() + number.size(), value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numbers.size()));
+}
+BENCHMARK(BM_IntegerSwar)->DenseRange(1, 10)->Arg(16)->Arg(19);
+
+// Сканирование строки с тремя целыми полями разной длины.
+void BM_ScanIntegers(benchmark::State& state) {
+    const auto pattern = stdx::scan_pattern<unsigned, int, unsigned long long>::compile("{%u} {} {%u}").value();
+    const std::string line = "4242 -17 1704067200123";
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.scan(line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_ScanIntegers);
+
+}  // namespace
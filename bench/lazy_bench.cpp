@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+#include "lazy.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Широкая запись из шестнадцати полей, из которой запрос читает только два.
+constexpr std::string_view wide_format =
+    "{%u} {%s} {%s} {%d} {%u} {%f} {%f} {%f} {%s} {%d} {%d} {%f} {%f} {%s} {%u} {%f}";
+constexpr std::string_view wide_line =
+    "1700000000 host-0042 GET 200 5120 0.031 0.125 17.5 /api/v2/items -1 42 3.25 99.75 eu-west 8080 0.5";
+
+using wide_pattern = stdx::scan_pattern<unsigned, std::string_view, std::string_view, int, unsigned, double, double,
+                                        double, std::string_view, int, int, double, double, std::string_view,
+                                        unsigned, double>;
+
+// Полная конверсия всех полей и чтение двух из них.
+void BM_WideRecordEager(benchmark::State& state) {
+    const auto pattern = wide_pattern::compile(wide_format).value();
+    for(auto _ : state) {
+        auto result = pattern.scan(wide_line);
+        benchmark::DoNotOptimize(std::get<3>(result->result));
+        benchmark::DoNotOptimize(std::get<7>(result->result));
+    }
+}
+BENCHMARK(BM_WideRecordEager);
+
+// Отложенная конверсия: выделяются границы всех полей, а конвертируются только прочитанные.
+void BM_WideRecordLazy(benchmark::State& state) {
+    const auto pattern = wide_pattern::compile(wide_format).value();
+    for(auto _ : state) {
+        auto record = stdx::scan_lazy(wide_line, pattern);
+        benchmark::DoNotOptimize(record->get<3>());
+        benchmark::DoNotOptimize(record->get<7>());
+    }
+}
+BENCHMARK(BM_WideRecordLazy);
+
+// Неиспользуемые поля пропускаются плейсхолдером {*} и не конвертируются.
+void BM_WideRecordSkip(benchmark::State& state) {
+    const auto pattern =
+        stdx::scan_pattern<stdx::skip, stdx::skip, stdx::skip, int, stdx::skip, stdx::skip, stdx::skip, double,
+                           stdx::skip, stdx::skip, stdx::skip, stdx::skip, stdx::skip, stdx::skip, stdx::skip,
+                           stdx::skip>::compile("{*} {*} {*} {%d} {*} {*} {*} {%f} {*} {*} {*} {*} {*} {*} {*} {*}")
+            .value();
+    for(auto _ : state) {
+        auto result = pattern.scan(wide_line);
+        benchmark::DoNotOptimize(std::get<3>(result->result));
+        benchmark::DoNotOptimize(std::get<7>(result->result));
+    }
+}
+BENCHMARK(BM_WideRecordSkip);
+
+}  // namespace
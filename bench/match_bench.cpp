@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+
+#include "batch.hpp"
+#include "match.hpp"
+
+namespace {
+
+constexpr std::string_view log_format = "{%s} {%s} status={%u} took={%f}";
+
+// Журнал из count строк, в котором формату соответствует каждая every-я строка.
+std::string make_log(std::size_t count, std::size_t every) {
+    std::string buffer;
+    for(std::size_t i = 0; i < count; ++i) {
+        if(i % every == 0) {
+            buffer += "GET /api/items/" + std::to_string(i) + " status=" + std::to_string(200 + i % 5) + " took=" +
+                      std::to_string(i % 97) + ".25\n";
+        }
+        else {
+            buffer += "debug: cache hit for key " + std::to_string(i) + " in shard " + std::to_string(i % 16) + "\n";
+        }
+    }
+    return buffer;
+}
+
+// Нижняя граница: подсчёт строк без какой-либо проверки.
+void BM_CountLines(benchmark::State& state) {
+    const auto buffer = make_log(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(std::count(buffer.begin(), buffer.end(), '\n'));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_CountLines)->Args({100000, 1})->Args({100000, 10});
+
+void BM_CountMatchesStructure(benchmark::State& state) {
+    const auto buffer  = make_log(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    const auto matcher = stdx::scan_matcher::compile(log_format).value();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::count_matches(buffer, matcher));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_CountMatchesStructure)->Args({100000, 1})->Args({100000, 10});
+
+void BM_CountMatchesLexical(benchmark::State& state) {
+    const auto buffer  = make_log(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    const auto matcher = stdx::scan_matcher::compile(log_format, stdx::match_mode::lexical).value();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::count_matches(buffer, matcher));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_CountMatchesLexical)->Args({100000, 1})->Args({100000, 10});
+
+// Подсчёт через полное пакетное сканирование с конверсией полей.
+void BM_CountViaScanBatch(benchmark::State& state) {
+    const auto buffer  = make_log(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    const auto pattern = stdx::scan_pattern<std::string_view, std::string_view, unsigned, double>::compile(log_format)
+                             .value();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::scan_batch(buffer, pattern).valid_count());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_CountViaScanBatch)->Args({100000, 1})->Args({100000, 10});
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "parallel.hpp"
+
+namespace {
+
+constexpr std::string_view log_format = "[{%u}] {} id={%d} took {%f} ms";
+
+// Сгенерированный в памяти лог размером SCAN_BENCH_PARALLEL_MB мегабайт (по умолчанию 512 МБ).
+const std::string& log_buffer() {
+    static const std::string buffer = [] {
+        std::size_t megabytes = 512;
+        if(const char* env = std::getenv("SCAN_BENCH_PARALLEL_MB")) {
+            megabytes = std::strtoull(env, nullptr, 10);
+        }
+        std::string result;
+        result.reserve(megabytes * 1024 * 1024 + 128);
+        for(std::size_t i = 0; result.size() < megabytes * 1024 * 1024; ++i) {
+            result += "[" + std::to_string(1'700'000'000 + i) + "] GET id=" + std::to_string(i % 100'000) + " took " +
+                      std::to_string(i % 1000) + ".5 ms\n";
+        }
+        return result;
+    }();
+    return buffer;
+}
+
+// Степени двойки до числа ядер и само число ядер.
+void thread_counts(benchmark::internal::Benchmark* bench) {
+    const auto max_threads = static_cast<int64_t>(std::max(1u, std::thread::hardware_concurrency()));
+    bench->ArgName("threads");
+    for(int64_t threads = 1; threads <= max_threads; threads *= 2) {
+        bench->Arg(threads);
+    }
+    if((max_threads & (max_threads - 1)) != 0) {
+        bench->Arg(max_threads);
+    }
+}
+
+// Масштабирование параллельного сканирования от 1 до N потоков.
+void BM_ScanParallel(benchmark::State& state) {
+    const auto& buffer = log_buffer();
+    const auto pattern = stdx::scan_pattern<unsigned int, std::string_view, int, double>::compile(log_format).value();
+    const stdx::parallel_options options {.threads = static_cast<std::size_t>(state.range(0))};
+    for(auto _ : state) {
+        auto results = stdx::scan_parallel(buffer, pattern, options);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_ScanParallel)->Apply(thread_counts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Передача результатов в обработчик без накопления: считаются только успешно разобранные строки.
+void BM_ScanParallelSink(benchmark::State& state) {
+    const auto& buffer = log_buffer();
+    const auto pattern = stdx::scan_pattern<unsigned int, std::string_view, int, double>::compile(log_format).value();
+    const stdx::parallel_options options {.threads = static_cast<std::size_t>(state.range(0))};
+    for(auto _ : state) {
+        std::atomic<std::size_t> matched {0};
+        stdx::scan_parallel(buffer, pattern, [&](std::size_t, auto&& line) {
+            if(line) {
+                matched.fetch_add(1, std::memory_order_relaxed);
+            }
+        }, options);
+        benchmark::DoNotOptimize(matched.load());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_ScanParallelSink)->Apply(thread_counts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
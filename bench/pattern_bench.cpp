@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view log_format = "[{%u}] {%s} id={%d} took {%f} ms";
+
+std::vector<std::string> make_log_lines(std::size_t count) {
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        lines.push_back("[" + std::to_string(1'700'000'000 + i) + "] GET id=" + std::to_string(i * 7) + " took " +
+                        std::to_string(i % 1000) + ".25 ms");
+    }
+    return lines;
+}
+
+// Стоимость строки для scan: форматная строка разбирается при каждом вызове.
+void BM_ScanPerLine(benchmark::State& state) {
+    const auto lines = make_log_lines(1024);
+    std::size_t i    = 0;
+    for(auto _ : state) {
+        auto result = stdx::scan<unsigned int, std::string, int, double>(lines[i++ % lines.size()], log_format);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScanPerLine);
+
+// Стоимость строки для scan_pattern: форматная строка разобрана заранее.
+void BM_PatternPerLine(benchmark::State& state) {
+    const auto lines   = make_log_lines(1024);
+    const auto pattern = stdx::scan_pattern<unsigned int, std::string, int, double>::compile(log_format).value();
+    std::size_t i      = 0;
+    for(auto _ : state) {
+        auto result = stdx::scan(lines[i++ % lines.size()], pattern);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PatternPerLine);
+
+// Стоимость строки для scan_format: форматная строка разобрана и проверена при компиляции.
+void BM_ScanFormatPerLine(benchmark::State& state) {
+    const auto lines = make_log_lines(1024);
+    constexpr stdx::scan_format<unsigned int, std::string, int, double> format {log_format};
+    std::size_t i = 0;
+    for(auto _ : state) {
+        auto result = stdx::scan(lines[i++ % lines.size()], format);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScanFormatPerLine);
+
+// То же для формата-параметра шаблона: вид спецификатора каждого поля известен при компиляции.
+void BM_ScanStaticPerLine(benchmark::State& state) {
+    const auto lines = make_log_lines(1024);
+    std::size_t i    = 0;
+    for(auto _ : state) {
+        auto result = stdx::scan_static<"[{%u}] {%s} id={%d} took {%f} ms", unsigned int, std::string, int, double>(
+            lines[i++ % lines.size()]);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScanStaticPerLine);
+
+}  // namespace
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "pipeline.hpp"
+
+namespace {
+
+constexpr std::string_view log_format = "[{%u}] GET {%s} id={%d} took {%f} ms";
+
+const std::string& pipeline_log() {
+    static const std::string content = [] {
+        std::string result;
+        for(std::size_t i = 0; i < 100'000; ++i) {
+            result += "[" + std::to_string(1'700'000'000 + i) + "] GET /api/v1/items id=" +
+                      std::to_string(i % 100'000) + " took " + std::to_string(i % 1000) + ".5 ms\n";
+        }
+        return result;
+    }();
+    return content;
+}
+
+// Источник с ненулевой стоимостью чтения (распаковка, контрольная сумма): passes проходов по каждому байту.
+stdx::read_function costly_reader(const std::string& content, int passes) {
+    return [&content, passes, position = std::size_t {0}](char* buffer, std::size_t size) mutable -> std::ptrdiff_t {
+        const std::size_t count = std::min(size, content.size() - position);
+        std::memcpy(buffer, content.data() + position, count);
+        for(int pass = 0; pass < passes; ++pass) {
+            unsigned checksum = 0;
+            for(std::size_t i = 0; i < count; ++i) {
+                checksum = checksum * 31 + static_cast<unsigned char>(buffer[i]);
+            }
+            benchmark::DoNotOptimize(checksum);
+        }
+        position += count;
+        return static_cast<std::ptrdiff_t>(count);
+    };
+}
+
+// Чтение и сканирование по очереди в одном потоке.
+void BM_SequentialReadAndScan(benchmark::State& state) {
+    const auto& content = pipeline_log();
+    for(auto _ : state) {
+        auto lines = stdx::scan_stream<unsigned, std::string_view, int, double>(
+            costly_reader(content, static_cast<int>(state.range(0))), log_format, 256 * 1024);
+        std::size_t matched = 0;
+        for(const auto& line : lines.value()) {
+            matched += line.has_value();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_SequentialReadAndScan)->Arg(0)->Arg(4)->UseRealTime();
+
+// Чтение и разрезание на строки в отдельном потоке, конверсия в вызывающем.
+void BM_PipelinedReadAndScan(benchmark::State& state) {
+    const auto& content = pipeline_log();
+    const auto pattern  = stdx::scan_pattern<unsigned, std::string_view, int, double>::compile(log_format).value();
+    for(auto _ : state) {
+        stdx::details::line_pipeline pipeline(costly_reader(content, static_cast<int>(state.range(0))), {});
+        std::size_t matched = 0;
+        while(const auto* chunk = pipeline.next()) {
+            for(std::size_t i = 0; i < chunk->lines(); ++i) {
+                matched += pattern.scan(chunk->line(i)).has_value();
+            }
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_PipelinedReadAndScan)->Arg(0)->Arg(4)->UseRealTime();
+
+#if defined(__cpp_lib_generator)
+
+void BM_ScanLinesGenerator(benchmark::State& state) {
+    const auto& content = pipeline_log();
+    for(auto _ : state) {
+        auto records = stdx::scan_lines<unsigned, std::string_view, int, double>(
+            costly_reader(content, static_cast<int>(state.range(0))), log_format);
+        std::size_t matched = 0;
+        for(auto&& record : records.value()) {
+            matched += record.has_value();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_ScanLinesGenerator)->Arg(0)->Arg(4)->UseRealTime();
+
+#endif
+
+}  // namespace
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "pattern.hpp"
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view record_format = "{%s} user={%s} path={%s} status={%d}";
+
+std::vector<std::string> make_records(std::size_t count) {
+    std::vector<std::string> records;
+    records.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        records.push_back("2024-01-01T12:00:" + std::to_string(10 + i % 50) + ".000Z user=customer-account-" +
+                          std::to_string(i) + " path=/api/v2/orders/" + std::to_string(i * 13) + "/items status=200");
+    }
+    return records;
+}
+
+// Пиковый RSS процесса в килобайтах. Значение не убывает, поэтому для сравнения бенчмарки стоит запускать по одному
+// через --benchmark_filter.
+double max_rss_kb() {
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss);
+}
+
+// Пакет записей с владеющими строками на стандартном аллокаторе: по выделению на каждое длинное поле.
+void BM_OwnedStringsDefaultAllocator(benchmark::State& state) {
+    const auto pattern =
+        stdx::scan_pattern<std::string, std::string, std::string, int>::compile(record_format).value();
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+    using result_type  = decltype(pattern.scan(records[0]));
+    for(auto _ : state) {
+        std::vector<result_type> batch;
+        batch.reserve(records.size());
+        for(const auto& record : records) {
+            batch.push_back(pattern.scan(record));
+        }
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["max_rss_kb"] = max_rss_kb();
+}
+BENCHMARK(BM_OwnedStringsDefaultAllocator)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+
+// Тот же пакет с полями std::pmr::string в монотонной арене, которая освобождается целиком после пакета.
+void BM_OwnedStringsArena(benchmark::State& state) {
+    const auto pattern =
+        stdx::scan_pattern<std::pmr::string, std::pmr::string, std::pmr::string, int>::compile(record_format).value();
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+    std::pmr::monotonic_buffer_resource arena {std::size_t {64} << 20};
+    using result_type = decltype(pattern.scan(records[0], &arena));
+    for(auto _ : state) {
+        {
+            std::pmr::vector<result_type> batch {&arena};
+            batch.reserve(records.size());
+            for(const auto& record : records) {
+                batch.push_back(pattern.scan(record, &arena));
+            }
+            benchmark::DoNotOptimize(batch.data());
+        }
+        arena.release();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["max_rss_kb"] = max_rss_kb();
+}
+BENCHMARK(BM_OwnedStringsArena)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+
+}  // namespace
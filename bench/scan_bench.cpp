@@ -0,0 +1,233 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "decimal.hpp"
+#include "into.hpp"
+#include "pattern.hpp"
+#include "scan.hpp"
+
+// Сводный набор бенчмарков scan: все типы и спецификаторы, одно и несколько полей, успешный и неуспешный разбор,
+// короткие и длинные литералы, а также базовые реализации на sscanf и std::from_chars. Каждая итерация разбирает одну
+// строку, поэтому столбец Time - это наносекунды на строку; bytes_per_second - пропускная способность, а allocs -
+// среднее число выделений памяти на вызов. Для отслеживания регрессий результаты сохраняются в JSON целью
+// scan_bench_json и сравниваются утилитой tools/compare.py из Google Benchmark.
+
+namespace {
+std::atomic<std::size_t> allocations_count {0};
+}  // namespace
+
+// Глобальная замена operator new, подсчитывающая выделения памяти во всём бинарнике бенчмарков.
+void* operator new(std::size_t size) {
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if(void* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// Общий цикл замера: scan_line вызывается для input на каждой итерации и должен вернуть признак успеха, который
+// сверяется с ожидаемым, чтобы бенчмарк случайно не мерил не тот путь.
+template<typename F> void measure(benchmark::State& state, std::string_view input, bool expect_success, F scan_line) {
+    const auto before = allocations_count.load(std::memory_order_relaxed);
+    for(auto _ : state) {
+        // Копия помечается изменяемой, чтобы компилятор не вынес разбор неизменной строки из цикла.
+        std::string_view line = input;
+        benchmark::DoNotOptimize(line);
+        bool success = scan_line(line);
+        benchmark::DoNotOptimize(success);
+        if(success != expect_success) {
+            state.SkipWithError("unexpected scan outcome");
+            break;
+        }
+    }
+    const auto allocations = allocations_count.load(std::memory_order_relaxed) - before;
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// Регистрация пары бенчмарков для набора типов Ts: scan с разбором формата на каждом вызове и scan_pattern,
+// скомпилированный заранее.
+template<typename... Ts>
+void register_scan(const std::string& name, std::string_view format, std::string_view input, bool expect_success) {
+    benchmark::RegisterBenchmark(("BM_Scan/" + name).c_str(), [=](benchmark::State& state) {
+        measure(state, input, expect_success,
+                [&](std::string_view line) { return stdx::scan<Ts...>(line, format).has_value(); });
+    });
+    benchmark::RegisterBenchmark(("BM_Pattern/" + name).c_str(), [=](benchmark::State& state) {
+        auto pattern = stdx::scan_pattern<Ts...>::compile(format);
+        if(!pattern) {
+            state.SkipWithError("format does not compile");
+            return;
+        }
+        measure(state, input, expect_success, [&](std::string_view line) { return pattern->scan(line).has_value(); });
+    });
+}
+
+using price = stdx::decimal<std::int64_t, 4>;
+
+constexpr std::string_view long_string = "a-long-field-value-well-beyond-the-small-string-buffer";
+
+[[maybe_unused]] const bool registered = [] {
+    // Одно поле: каждый поддерживаемый тип с каждым допустимым для него спецификатором.
+    register_scan<signed char>("signed_char/d", "{%d}", "-42", true);
+    register_scan<signed char>("signed_char/empty", "{}", "-42", true);
+    register_scan<unsigned char>("unsigned_char/u", "{%u}", "200", true);
+    register_scan<short>("short/d", "{%d}", "-12345", true);
+    register_scan<unsigned short>("unsigned_short/u", "{%u}", "54321", true);
+    register_scan<int>("int/d", "{%d}", "-1234567", true);
+    register_scan<int>("int/empty", "{}", "-1234567", true);
+    register_scan<unsigned>("unsigned/u", "{%u}", "3456789012", true);
+    register_scan<long long>("long_long/d", "{%d}", "-1234567890123456", true);
+    register_scan<unsigned long long>("unsigned_long_long/u", "{%u}", "12345678901234567890", true);
+    register_scan<unsigned long long>("unsigned_long_long/empty", "{}", "1234567890123456789", true);
+    register_scan<float>("float/f", "{%f}", "3.14159", true);
+    register_scan<float>("float/empty", "{}", "3.14159", true);
+    register_scan<double>("double/f", "{%f}", "2.718281828459045", true);
+    register_scan<double>("double/empty", "{}", "2.718281828459045", true);
+    register_scan<price>("decimal/f", "{%f}", "187.2651", true);
+    register_scan<price>("decimal/empty", "{}", "187.2651", true);
+    register_scan<std::string>("string/s", "{%s}", long_string, true);
+    register_scan<std::string>("string/empty", "{}", long_string, true);
+    register_scan<std::pmr::string>("pmr_string/s", "{%s}", long_string, true);
+    register_scan<std::string_view>("string_view/s", "{%s}", long_string, true);
+    register_scan<std::string_view>("string_view/empty", "{}", long_string, true);
+    register_scan<const char*>("c_string/s", "{%s}", long_string, true);
+
+    // Несколько полей: типичная строка лога с четырьмя и восемью полями.
+    register_scan<unsigned, std::string_view, int, double>("fields/4", "[{%u}] {%s} id={%d} took {%f} ms",
+                                                           "[1700000000] GET id=4242 took 12.25 ms", true);
+    register_scan<unsigned, std::string_view, std::string_view, int, unsigned, double, std::string_view, int>(
+        "fields/8", "{%u} {} {} {%d} {%u} {%f} {} {%d}",
+        "1700000000 host-0042 GET 200 5120 0.031 /api/v2/items -1", true);
+
+    // Короткие и длинные литералы между одинаковыми полями.
+    register_scan<int, int>("literals/short", "{%d},{%d}", "12345,67890", true);
+    register_scan<int, int>("literals/long", "request_id={%d} upstream_processing_time_ms={%d}",
+                            "request_id=12345 upstream_processing_time_ms=67890", true);
+
+    // Неуспешный разбор: несовпадение литерала, некорректное число и выход за диапазон типа.
+    register_scan<unsigned, std::string_view, int, double>("fail/literal", "[{%u}] {%s} id={%d} took {%f} ms",
+                                                           "DEBUG worker-17 heartbeat ok", false);
+    register_scan<unsigned, std::string_view, int, double>("fail/conversion", "[{%u}] {%s} id={%d} took {%f} ms",
+                                                           "[1700000000] GET id=??? took 12.25 ms", false);
+    register_scan<signed char>("fail/range", "{}", "300", false);
+    return true;
+}();
+
+// Проверенный при компиляции формат для той же строки, что и fields/4.
+void BM_ScanFormat_Fields4(benchmark::State& state) {
+    static constexpr stdx::scan_format<unsigned, std::string_view, int, double> format {
+        "[{%u}] {%s} id={%d} took {%f} ms"};
+    measure(state, "[1700000000] GET id=4242 took 12.25 ms", true,
+            [](std::string_view line) { return format.scan(line).has_value(); });
+}
+BENCHMARK(BM_ScanFormat_Fields4);
+
+// Запись строки из четырёх полей в переиспользуемую структуру: строковый член сохраняет буфер между вызовами.
+void BM_ScanInto_Fields4(benchmark::State& state) {
+    struct request {
+        unsigned timestamp;
+        std::string method;
+        int id;
+        double took;
+    } out {};
+    measure(state, "[1700000000] a-method-name-beyond-small-string id=4242 took 12.25 ms", true,
+            [&](std::string_view line) {
+                return stdx::scan_into(line, "[{%u}] {%s} id={%d} took {%f} ms", out).has_value();
+            });
+}
+BENCHMARK(BM_ScanInto_Fields4);
+
+// Та же строка через scan: результат и его строковое поле создаются заново на каждом вызове.
+void BM_ScanTuple_Fields4(benchmark::State& state) {
+    measure(state, "[1700000000] a-method-name-beyond-small-string id=4242 took 12.25 ms", true,
+            [](std::string_view line) {
+                return stdx::scan<unsigned, std::string, int, double>(line, "[{%u}] {%s} id={%d} took {%f} ms")
+                    .has_value();
+            });
+}
+BENCHMARK(BM_ScanTuple_Fields4);
+
+// Базовая реализация на sscanf для одного целого поля. sscanf требует завершающего нуля, поэтому строка копируется.
+void BM_Sscanf_Int(benchmark::State& state) {
+    measure(state, "-1234567", true, [](std::string_view line) {
+        char buffer[64];
+        line.copy(buffer, sizeof(buffer) - 1);
+        buffer[std::min(line.size(), sizeof(buffer) - 1)] = '\0';
+        int value                                         = 0;
+        return std::sscanf(buffer, "%d", &value) == 1;
+    });
+}
+BENCHMARK(BM_Sscanf_Int);
+
+// Базовая реализация на sscanf для строки из четырёх полей.
+void BM_Sscanf_Fields4(benchmark::State& state) {
+    measure(state, "[1700000000] GET id=4242 took 12.25 ms", true, [](std::string_view line) {
+        char buffer[128];
+        line.copy(buffer, sizeof(buffer) - 1);
+        buffer[std::min(line.size(), sizeof(buffer) - 1)] = '\0';
+        unsigned timestamp                                = 0;
+        char method[16];
+        int id      = 0;
+        double took = 0;
+        return std::sscanf(buffer, "[%u] %15s id=%d took %lf ms", &timestamp, method, &id, &took) == 4;
+    });
+}
+BENCHMARK(BM_Sscanf_Fields4);
+
+// Базовая реализация на std::from_chars для одного целого поля.
+void BM_FromChars_Int(benchmark::State& state) {
+    measure(state, "-1234567", true, [](std::string_view line) {
+        int value      = 0;
+        auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), value);
+        return ec == std::errc {};
+    });
+}
+BENCHMARK(BM_FromChars_Int);
+
+// Разбор строки из четырёх полей вручную: поиск литералов через std::string_view::find и std::from_chars.
+void BM_FromChars_Fields4(benchmark::State& state) {
+    measure(state, "[1700000000] GET id=4242 took 12.25 ms", true, [](std::string_view line) {
+        if(!line.starts_with('[')) {
+            return false;
+        }
+        auto close = line.find("] ");
+        auto id    = line.find(" id=", close);
+        auto took  = line.find(" took ", id);
+        auto ms    = line.find(" ms", took);
+        if(ms == std::string_view::npos) {
+            return false;
+        }
+        unsigned timestamp      = 0;
+        int request             = 0;
+        double duration         = 0;
+        std::string_view method = line.substr(close + 2, id - close - 2);
+        benchmark::DoNotOptimize(method);
+        return std::from_chars(line.data() + 1, line.data() + close, timestamp).ec == std::errc {} &&
+               std::from_chars(line.data() + id + 4, line.data() + took, request).ec == std::errc {} &&
+               std::from_chars(line.data() + took + 6, line.data() + ms, duration).ec == std::errc {};
+    });
+}
+BENCHMARK(BM_FromChars_Fields4);
+
+}  // namespace
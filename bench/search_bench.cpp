@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "pattern.hpp"
+#include "search.hpp"
+#include "simd.hpp"
+
+namespace {
+
+// Патологический случай для поиска с проверкой кандидатов: литерал из 'a' с 'b' в середине и строка из 'a', где
+// 'b' стоит чаще, чем в литерале. Первый и последний байты литерала совпадают почти в каждой позиции, а каждый
+// кандидат отбрасывается только после сравнения около половины литерала.
+std::string adversarial_literal(std::size_t length) {
+    std::string literal(length, 'a');
+    literal[length / 2] = 'b';
+    return literal;
+}
+
+std::string adversarial_line(std::size_t length) {
+    std::string line = "id=7 ";
+    while(line.size() < 16 * 1024) {
+        line += std::string(length / 2 - 1, 'a') + "b";
+    }
+    return line;
+}
+
+// Обычная строка лога с длинным литералом.
+const std::string& log_line() {
+    static const std::string line = "2024-01-01T12:00:00.000Z host-0042 service-frontend request_id=7f3a9c0e12 "
+                                    "user_agent=curl/8.5.0 upstream_status_code=200 latency_ms=12";
+    return line;
+}
+
+constexpr std::string_view log_literal = " upstream_status_code=";
+
+// Векторный поиск с проверкой кандидатов memcmp: O(n·m) на патологической строке.
+void BM_AdversarialFindLiteral(benchmark::State& state) {
+    const auto length      = static_cast<std::size_t>(state.range(0));
+    const std::string line = adversarial_line(length);
+    const auto literal     = adversarial_literal(length);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::details::find_literal(line, literal));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_AdversarialFindLiteral)->Arg(32)->Arg(128)->Arg(512);
+
+// Two-Way по готовой факторизации: линейно при любой длине литерала.
+void BM_AdversarialTwoWay(benchmark::State& state) {
+    const auto length      = static_cast<std::size_t>(state.range(0));
+    const std::string line = adversarial_line(length);
+    const auto literal     = adversarial_literal(length);
+    const auto plan        = stdx::details::plan_literal(literal);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::details::find_literal_linear(line, literal, plan));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_AdversarialTwoWay)->Arg(32)->Arg(128)->Arg(512);
+
+// Сопоставление записи с длинным разделителем на патологической строке через скомпилированный шаблон.
+void BM_AdversarialPattern(benchmark::State& state) {
+    const auto length      = static_cast<std::size_t>(state.range(0));
+    const std::string line = adversarial_line(length);
+    const auto format      = "id={%d} {}" + adversarial_literal(length) + "{}";
+    const auto pattern     = stdx::scan_pattern<int, std::string_view, std::string_view>::compile(format).value();
+    std::array<std::string_view, 3> fields;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.match(line, fields));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_AdversarialPattern)->Arg(32)->Arg(128)->Arg(512);
+
+// Длинный литерал в обычной строке лога: векторный поиск и Two-Way с пропуском по началу правой части.
+void BM_LogFindLiteral(benchmark::State& state) {
+    const std::string_view line = log_line();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::details::find_literal(line, log_literal));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_LogFindLiteral);
+
+void BM_LogTwoWay(benchmark::State& state) {
+    const std::string_view line = log_line();
+    const auto plan             = stdx::details::plan_literal(log_literal);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::details::find_literal_linear(line, log_literal, plan));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_LogTwoWay);
+
+// Обычная строка лога через скомпилированный шаблон с длинным литералом.
+void BM_LogPattern(benchmark::State& state) {
+    const auto pattern =
+        stdx::scan_pattern<std::string_view, std::string_view, int, int>::compile("{} {}" + std::string {log_literal} +
+                                                                                  "{%d} latency_ms={%d}")
+            .value();
+    const std::string_view line = log_line();
+    std::array<std::string_view, 4> fields;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.match(line, fields));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_LogPattern);
+
+}  // namespace
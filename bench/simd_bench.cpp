@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "pattern.hpp"
+#include "simd.hpp"
+
+namespace {
+
+// Типичная строка лога, в которой разделитель стоит ближе к концу.
+const std::string& sample_line() {
+    static const std::string line =
+        "2024-01-01T12:00:00.000Z host-0042 service-frontend request_id=7f3a9c0e12 user_agent=curl/8.5.0 status 200";
+    return line;
+}
+
+// Поиск разделителя заданной длины через std::string_view::find.
+void BM_FindStringView(benchmark::State& state) {
+    const std::string_view line = sample_line();
+    const std::string needle    = std::string {" status 200"}.substr(0, static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(line.find(needle));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_FindStringView)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+// Поиск разделителя той же длины векторизованным find_literal.
+void BM_FindLiteralSimd(benchmark::State& state) {
+    const std::string_view line = sample_line();
+    const std::string needle    = std::string {" status 200"}.substr(0, static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stdx::details::find_literal(line, needle));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_FindLiteralSimd)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+// Выделение полей строки шаблоном с однобайтовыми и двухбайтовыми разделителями.
+void BM_PatternMatchFields(benchmark::State& state) {
+    const auto pattern = stdx::scan_pattern<std::string_view, std::string_view, std::string_view, int>::compile(
+                             "{} {} {}, status {%d}")
+                             .value();
+    const std::string line =
+        "2024-01-01T12:00:00.000Z host-0042 service-frontend request_id=7f3a9c0e12 curl/8.5.0, status 200";
+    std::array<std::string_view, 4> fields;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(pattern.match(line, fields));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_PatternMatchFields);
+
+}  // namespace
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include "stream.hpp"
+
+namespace {
+
+// Лог в памяти, который читается через std::istream кусками разного размера.
+const std::string& stream_log() {
+    static const std::string content = [] {
+        std::string result;
+        for(std::size_t i = 0; i < 100'000; ++i) {
+            result += "[" + std::to_string(1'700'000'000 + i) + "] GET /api/v1/items id=" +
+                      std::to_string(i % 100'000) + " took " + std::to_string(i % 1000) + ".5 ms\n";
+        }
+        return result;
+    }();
+    return content;
+}
+
+// Пропускная способность потокового сканирования в зависимости от ёмкости буфера.
+void BM_ScanStreamThroughput(benchmark::State& state) {
+    const auto& content = stream_log();
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        std::istringstream input {content};
+        auto lines = stdx::scan_stream<unsigned, std::string_view, int, double>(
+            input, "[{%u}] GET {%s} id={%d} took {%f} ms", capacity);
+        std::size_t matched = 0;
+        for(const auto& line : lines.value()) {
+            matched += line.has_value();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_ScanStreamThroughput)->Arg(256)->Arg(4 << 10)->Arg(64 << 10);
+
+}  // namespace
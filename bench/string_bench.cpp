@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pattern.hpp"
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view access_format = "{%s} {%s} {%s} agent={%s}";
+
+std::vector<std::string> make_access_lines(std::size_t count) {
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        lines.push_back("edge-node-" + std::to_string(i % 64) + ".eu-central.example.net GET /api/v2/items/" +
+                        std::to_string(i * 31) + "/details?expand=owner,tags agent=Mozilla/5.0 (X11; Linux x86_64)");
+    }
+    return lines;
+}
+
+// Строковые поля копируются в std::string, а затем хешируются.
+void BM_StringFieldsCopied(benchmark::State& state) {
+    const auto pattern =
+        stdx::scan_pattern<std::string, std::string, std::string, std::string>::compile(access_format).value();
+    const auto lines = make_access_lines(1024);
+    std::size_t i    = 0;
+    for(auto _ : state) {
+        auto result = pattern.scan(lines[i++ % lines.size()]);
+        benchmark::DoNotOptimize(std::hash<std::string> {}(std::get<2>(result->result)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringFieldsCopied);
+
+// Строковые поля указывают во входную строку и хешируются без копирования.
+void BM_StringFieldsBorrowed(benchmark::State& state) {
+    const auto pattern = stdx::scan_pattern<std::string_view, std::string_view, std::string_view,
+                                            std::string_view>::compile(access_format)
+                             .value();
+    const auto lines = make_access_lines(1024);
+    std::size_t i    = 0;
+    for(auto _ : state) {
+        auto result = stdx::scan_borrowed(lines[i++ % lines.size()], pattern);
+        benchmark::DoNotOptimize(std::hash<std::string_view> {}(std::get<2>(result->result)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringFieldsBorrowed);
+
+}  // namespace
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "parse.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Ссылка на строковое поле внутри исходного буфера пакета: смещение от начала буфера и длина.
+struct string_ref {
+    std::size_t offset {};
+    std::size_t length {};
+
+    friend bool operator==(const string_ref&, const string_ref&) = default;
+};
+
+namespace details {
+
+// Строковые поля в колонках не копируются, а хранятся ссылкой string_ref на исходный буфер.
+template<typename T>
+concept is_string_column = is_c_string<T> || std::is_constructible_v<T, std::string_view>;
+
+template<typename T> struct column_value {
+    using type = std::remove_cv_t<T>;
+};
+
+template<is_string_column T> struct column_value<T> {
+    using type = string_ref;
+};
+
+template<typename T> using column_value_t = typename column_value<T>::type;
+
+// Конверсия поля строки пакета в значение колонки.
+template<typename T>
+bool convert_column_value(std::string_view buffer, std::string_view field, spec_kind kind,
+                          column_value_t<T>& value) {
+    if constexpr(is_string_column<T>) {
+        value = string_ref {static_cast<std::size_t>(field.data() - buffer.data()), field.size()};
+        return true;
+    }
+    else {
+        auto converted = convert_value<std::remove_cv_t<T>>(field, kind);
+        if(!converted) {
+            return false;
+        }
+        value = converted.value();
+        return true;
+    }
+}
+
+}  // namespace details
+
+// Результат пакетного сканирования в колоночном виде (struct-of-arrays): каждое поле формата пишется в свою
+// непрерывную колонку, а строки, не совпавшие с форматом, отмечаются нулевым битом в битовой карте validity.
+// Для невалидных строк в колонки записываются значения по умолчанию, чтобы индексы строк во всех колонках совпадали.
+template<typename... Ts> struct batch_result {
+    std::tuple<std::vector<details::column_value_t<Ts>>...> columns {};
+    std::vector<std::uint64_t> validity {};  // Бит (row % 64) слова (row / 64) равен 1, если строка row совпала.
+    std::size_t rows = 0;
+
+    template<std::size_t I> const auto& column() const noexcept {
+        return std::get<I>(columns);
+    }
+
+    bool valid(std::size_t row) const noexcept {
+        return (validity[row / 64] >> (row % 64)) & 1u;
+    }
+
+    std::size_t valid_count() const noexcept {
+        std::size_t count = 0;
+        for(auto word : validity) {
+            count += static_cast<std::size_t>(std::popcount(word));
+        }
+        return count;
+    }
+};
+
+// Пакетное сканирование буфера с записями, разделёнными '\n', по скомпилированному шаблону. Последняя запись может
+// не завершаться переводом строки.
+template<typename... Ts>
+batch_result<Ts...> scan_batch(std::string_view buffer, const scan_pattern<Ts...>& pattern) {
+    batch_result<Ts...> batch;
+
+    // Предварительный подсчёт строк, чтобы колонки не перевыделялись в процессе сканирования.
+    std::size_t expected_rows = static_cast<std::size_t>(std::count(buffer.begin(), buffer.end(), '\n'));
+    if(!buffer.empty() && buffer.back() != '\n') {
+        ++expected_rows;
+    }
+    std::apply([&](auto&... column) { (column.reserve(expected_rows), ...); }, batch.columns);
+    batch.validity.assign((expected_rows + 63) / 64, 0);
+
+    std::array<std::string_view, sizeof...(Ts)> fields;
+    std::tuple<details::column_value_t<Ts>...> row_values;
+    std::size_t position = 0;
+    while(position < buffer.size()) {
+        bool matched = pattern.match_line(buffer, position, fields);
+        if(matched) {
+            matched = [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+                return (details::convert_column_value<Ts>(buffer, fields[Ids], pattern.kind(Ids),
+                                                          std::get<Ids>(row_values)) &&
+                        ...);
+            }(std::index_sequence_for<Ts...> {});
+        }
+
+        if(matched) {
+            batch.validity[batch.rows / 64] |= std::uint64_t {1} << (batch.rows % 64);
+            [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+                (std::get<Ids>(batch.columns).push_back(std::get<Ids>(row_values)), ...);
+            }(std::index_sequence_for<Ts...> {});
+        }
+        else {
+            std::apply([](auto&... column) { (column.emplace_back(), ...); }, batch.columns);
+        }
+        ++batch.rows;
+    }
+    return batch;
+}
+
+// Пакетное сканирование буфера по форматной строке: формат компилируется один раз на весь пакет.
+template<typename... Ts>
+std::expected<batch_result<Ts...>, details::scan_error> scan_batch(std::string_view buffer, std::string_view format) {
+    auto pattern = scan_pattern<Ts...>::compile(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return scan_batch(buffer, pattern.value());
+}
+
+}  // namespace stdx
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "config.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Потокобезопасный кэш скомпилированных шаблонов для форматов, известных только во время выполнения (конфигурация,
+// пользовательские запросы). Отдельный экземпляр существует для каждого набора типов Ts..., поэтому ключ кэша -
+// пара из форматной строки и сигнатуры Ts...
+//
+// Чтение идёт через небольшой кэш потока с прямым отображением по хэшу формата и не берёт блокировок. Промах
+// обращается к общему кэшу с вытеснением давно не использованных (LRU) шаблонов, защищённому мьютексом. Шаблоны
+// неизменяемы и разделяются через std::shared_ptr, поэтому вытеснение из общего кэша не инвалидирует копии
+// в кэшах потоков; память ограничена ёмкостью общего кэша и thread_slots записями на поток.
+template<typename... Ts> class format_cache {
+public:
+    using pattern_ptr = std::shared_ptr<const scan_pattern<Ts...>>;
+
+    static constexpr std::size_t default_capacity = 256;
+    static constexpr std::size_t thread_slots     = 64;
+
+    static format_cache& instance() {
+        static format_cache cache;
+        return cache;
+    }
+
+    // Скомпилированный шаблон формата во владение вызывающего. Форматы с ошибкой не кэшируются: ошибка
+    // возвращается при каждом вызове.
+    std::expected<pattern_ptr, details::scan_error> get(std::string_view format) {
+        auto found = find_slot(format);
+        if(!found) {
+            return std::unexpected(std::move(found.error()));
+        }
+        return found.value()->pattern;
+    }
+
+    // Шаблон из кэша текущего потока без копирования std::shared_ptr, то есть без атомарных операций над общим
+    // счётчиком ссылок. Указатель действителен до следующего обращения к кэшу из этого же потока.
+    std::expected<const scan_pattern<Ts...>*, details::scan_error> find(std::string_view format) {
+        auto found = find_slot(format);
+        if(!found) {
+            return std::unexpected(std::move(found.error()));
+        }
+        return found.value()->pattern.get();
+    }
+
+    std::size_t capacity() const {
+        std::lock_guard lock {mutex_};
+        return capacity_;
+    }
+
+    // Изменение ёмкости общего кэша с немедленным вытеснением лишних шаблонов. При нулевой ёмкости общий кэш
+    // не хранит шаблонов, и повторно форматы переиспользуются только кэшами потоков.
+    void set_capacity(std::size_t capacity) {
+        std::lock_guard lock {mutex_};
+        capacity_ = capacity;
+        evict();
+    }
+
+    // Число шаблонов в общем кэше.
+    std::size_t size() const {
+        std::lock_guard lock {mutex_};
+        return index_.size();
+    }
+
+private:
+    struct slot {
+        std::size_t hash = 0;
+        pattern_ptr pattern {};
+    };
+
+    struct entry {
+        std::string format;
+        pattern_ptr pattern;
+    };
+
+    format_cache() = default;
+
+    static std::array<slot, thread_slots>& local_slots() {
+        thread_local std::array<slot, thread_slots> slots {};
+        return slots;
+    }
+
+    std::expected<slot*, details::scan_error> find_slot(std::string_view format) {
+        const auto hash = std::hash<std::string_view> {}(format);
+        auto& local     = local_slots()[hash % thread_slots];
+        if(local.pattern != nullptr && local.hash == hash && local.pattern->format() == format) [[likely]] {
+            return &local;
+        }
+
+        auto shared = get_shared(format);
+        if(!shared) {
+            return std::unexpected(std::move(shared.error()));
+        }
+        local = {hash, std::move(shared.value())};
+        return &local;
+    }
+
+    std::expected<pattern_ptr, details::scan_error> get_shared(std::string_view format) {
+        {
+            std::lock_guard lock {mutex_};
+            if(auto it = index_.find(format); it != index_.end()) {
+                // Найденный шаблон становится самым свежим.
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return it->second->pattern;
+            }
+        }
+
+        // Компиляция вне блокировки: параллельный промах по тому же формату лишь скомпилирует его повторно.
+        auto compiled = scan_pattern<Ts...>::compile(format);
+        if(!compiled) {
+            return std::unexpected(std::move(compiled.error()));
+        }
+        auto pattern = std::make_shared<const scan_pattern<Ts...>>(std::move(compiled.value()));
+
+        std::lock_guard lock {mutex_};
+        if(capacity_ == 0) {
+            return pattern;
+        }
+        if(auto it = index_.find(format); it != index_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->pattern;
+        }
+        entries_.push_front(entry {std::string {format}, pattern});
+        index_.emplace(entries_.front().format, entries_.begin());
+        evict();
+        return pattern;
+    }
+
+    // Вытеснение давно не использованных шаблонов сверх ёмкости; вызывается под mutex_.
+    void evict() {
+        while(index_.size() > capacity_) {
+            index_.erase(std::string_view {entries_.back().format});
+            entries_.pop_back();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::size_t capacity_ = default_capacity;
+    std::list<entry> entries_;  // От самого свежего к самому старому.
+    // Ключи указывают в строки entries_: узлы списка не перемещаются.
+    std::unordered_map<std::string_view, typename std::list<entry>::iterator> index_;
+};
+
+// Сканирование по runtime-формату через format_cache: формат разбирается один раз, а повторные вызовы с той же
+// строкой работают со скомпилированным шаблоном без явного управления объектами scan_pattern.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error> scan_cached(std::string_view input,
+                                                                            std::string_view format) {
+    auto pattern = format_cache<Ts...>::instance().find(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return pattern.value()->scan(input);
+}
+
+// Перегрузка scan_cached с ресурсом памяти для полей std::pmr::string.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error>
+scan_cached(std::string_view input, std::string_view format, std::pmr::memory_resource* resource) {
+    auto pattern = format_cache<Ts...>::instance().find(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return pattern.value()->scan(input, resource);
+}
+
+}  // namespace stdx
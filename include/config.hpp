@@ -0,0 +1,29 @@
+#pragma once
+
+// Настройки сборки, влияющие на код библиотеки. Задаются определениями препроцессора (опциями CMake) одинаково для
+// всей программы.
+
+// Сбор статистики сканирования, см. stats.hpp.
+#ifndef STDX_SCAN_STATS
+#    define STDX_SCAN_STATS 0
+#endif
+
+// Компактный бэкенд scan по runtime-формату, см. erased.hpp.
+#ifndef STDX_SCAN_ERASED
+#    define STDX_SCAN_ERASED 0
+#endif
+
+// Всё содержимое stdx объявлено во встроенном пространстве имён, имя которого зависит от обеих настроек: статистика
+// меняет раскладку scan_pattern и тела функций сканирования, а компактный бэкенд - тело scan. Единицы трансляции,
+// собранные с разными значениями, получают разные типы и символы, поэтому передача объектов библиотеки между ними
+// не компонуется, а не нарушает ODR молча. Для пользовательского кода пространство прозрачно: имена по-прежнему
+// stdx::scan, stdx::details::...
+#if STDX_SCAN_STATS && STDX_SCAN_ERASED
+#    define STDX_SCAN_ABI_NAMESPACE stats_on_erased
+#elif STDX_SCAN_STATS
+#    define STDX_SCAN_ABI_NAMESPACE stats_on
+#elif STDX_SCAN_ERASED
+#    define STDX_SCAN_ABI_NAMESPACE stats_off_erased
+#else
+#    define STDX_SCAN_ABI_NAMESPACE stats_off
+#endif
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <charconv>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "config.hpp"
+#include "integer.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Десятичное число с фиксированной точкой: значение равно units / 10^Scale. Разбирается прямо из цифр, без
+// промежуточного double, поэтому цены и суммы хранятся без ошибок двоичного округления.
+template<std::integral Int, unsigned Scale> struct decimal {
+    static_assert(Scale <= static_cast<unsigned>(std::numeric_limits<Int>::digits10),
+                  "10^Scale must be representable in Int");
+
+    using value_type                      = Int;
+    static constexpr unsigned scale       = Scale;
+    static constexpr std::uint64_t factor = [] {
+        std::uint64_t result = 1;
+        for(unsigned i = 0; i < Scale; ++i) {
+            result *= 10;
+        }
+        return result;
+    }();
+
+    Int units {};
+
+    constexpr double to_double() const noexcept {
+        return static_cast<double>(units) / static_cast<double>(factor);
+    }
+
+    friend constexpr bool operator==(const decimal&, const decimal&)  = default;
+    friend constexpr auto operator<=>(const decimal&, const decimal&) = default;
+};
+
+namespace details {
+
+template<typename T> struct is_decimal_type : std::false_type {};
+
+template<typename Int, unsigned Scale> struct is_decimal_type<decimal<Int, Scale>> : std::true_type {};
+
+template<typename T>
+concept is_decimal = is_decimal_type<std::remove_cv_t<T>>::value;
+
+// Разбор десятичной дроби вида [-]digits[.digits] в decimal<Int, Scale>. Контракт повторяет std::from_chars:
+// '+' и экспонента не допускаются, при ошибке value не меняется. Цифры дробной части сверх Scale округляются
+// до ближайшего (половина - от нуля).
+template<typename T>
+    requires is_decimal<T>
+constexpr std::from_chars_result parse_decimal(const char* first, const char* last, T& value) noexcept {
+    using int_t      = typename T::value_type;
+    using unsigned_t = std::make_unsigned_t<int_t>;
+
+    const char* p = first;
+    bool negative = false;
+    if constexpr(std::is_signed_v<int_t>) {
+        if(p != last && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+
+    // Целая часть разбирается тем же ядром, что и целые поля.
+    std::uint64_t whole = 0;
+    auto integer        = parse_integer(p, last, whole);
+    bool overflow       = integer.ec == std::errc::result_out_of_range;
+    bool has_digits     = integer.ptr != p;
+    p                   = integer.ptr;
+
+    std::uint64_t fraction   = 0;
+    unsigned fraction_digits = 0;
+    bool round_up            = false;
+    if(p != last && *p == '.') {
+        const char* fraction_first = ++p;
+        for(; p != last && static_cast<unsigned char>(*p - '0') < 10; ++p) {
+            if(fraction_digits < T::scale) {
+                fraction = fraction * 10 + static_cast<std::uint64_t>(*p - '0');
+                ++fraction_digits;
+            }
+            else if(p == fraction_first + T::scale) {
+                round_up = *p >= '5';
+            }
+        }
+        has_digits = has_digits || p != fraction_first;
+    }
+    if(!has_digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    for(; fraction_digits < T::scale; ++fraction_digits) {
+        fraction *= 10;
+    }
+
+    std::uint64_t magnitude = 0;
+    overflow |= __builtin_mul_overflow(whole, T::factor, &magnitude);
+    overflow |= __builtin_add_overflow(magnitude, fraction + (round_up ? 1 : 0), &magnitude);
+
+    const std::uint64_t max   = static_cast<unsigned_t>(std::numeric_limits<int_t>::max());
+    const std::uint64_t limit = negative ? max + 1 : max;
+    if(overflow || magnitude > limit) {
+        return {p, std::errc::result_out_of_range};
+    }
+    value.units =
+        negative ? static_cast<int_t>(static_cast<unsigned_t>(0u - magnitude)) : static_cast<int_t>(magnitude);
+    return {p, std::errc {}};
+}
+
+}  // namespace details
+
+}  // namespace stdx
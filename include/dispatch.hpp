@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Маршрутизация строк между набором форматов с разными типами полей. Ведущие литералы форматов (текст до первого
+// плейсхолдера) собираются в общее префиксное дерево, поэтому строка за один проход по своему началу попадает
+// к немногим кандидатам вместо последовательной пробы каждого формата.
+//
+// В отличие от scan, ведущий литерал формата обязан стоять в начале строки. Кандидаты проверяются от самого длинного
+// совпавшего префикса к более коротким, а при равных префиксах - в порядке добавления; строку получает обработчик
+// первого успешно разобравшего её формата. Формат без ведущего литерала подходит любой строке и пробуется последним.
+class scan_dispatcher {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    scan_dispatcher() : nodes_(1) {}
+
+    // Добавление формата с типами полей Ts... и обработчиком, который вызывается с разобранными полями как
+    // с аргументами. Возвращает ошибку, если формат не компилируется для Ts...
+    template<typename... Ts, typename Handler>
+        requires std::invocable<Handler&, Ts&&...>
+    std::expected<void, details::scan_error> add(std::string_view format, Handler handler) {
+        auto pattern = scan_pattern<Ts...>::compile(format);
+        if(!pattern) {
+            return std::unexpected(std::move(pattern.error()));
+        }
+        const auto prefix = pattern->literal(0);
+        const auto node   = insert(prefix);
+        nodes_[node].routes.push_back(routes_.size());
+        routes_.emplace_back(
+            [pattern = std::move(pattern.value()), handler = std::move(handler)](std::string_view line) mutable {
+                auto scanned = pattern.scan(line);
+                if(!scanned) {
+                    return false;
+                }
+                std::apply(handler, std::move(scanned->result));
+                return true;
+            });
+        link_fallbacks();
+        return {};
+    }
+
+    // Разбор строки подходящим форматом и вызов его обработчика. Возвращает индекс формата в порядке добавления
+    // либо npos, если строку не разобрал ни один формат.
+    std::size_t dispatch(std::string_view line) {
+        // Спуск по дереву до самого длинного ведущего литерала, которым начинается строка.
+        std::uint32_t node = 0;
+        for(std::size_t depth = 0; depth < line.size(); ++depth) {
+            const auto next = child(node, line[depth]);
+            if(next == no_node) {
+                break;
+            }
+            node = next;
+        }
+        if(nodes_[node].routes.empty()) {
+            node = nodes_[node].fallback;
+        }
+        // Подъём к более коротким префиксам только по узлам, на которых заканчиваются форматы.
+        for(; node != no_node; node = nodes_[node].fallback) {
+            for(std::size_t index : nodes_[node].routes) {
+                if(routes_[index](line)) {
+                    return index;
+                }
+            }
+        }
+        return npos;
+    }
+
+    // Число добавленных форматов.
+    std::size_t size() const noexcept {
+        return routes_.size();
+    }
+
+private:
+    static constexpr std::uint32_t no_node = static_cast<std::uint32_t>(-1);
+
+    struct edge {
+        char symbol;
+        std::uint32_t target;
+    };
+
+    struct node {
+        std::vector<edge> children {};       // Упорядочены по symbol.
+        std::vector<std::size_t> routes {};  // Форматы, ведущий литерал которых заканчивается здесь.
+        std::uint32_t fallback = no_node;    // Ближайший предок, на котором заканчиваются форматы.
+    };
+
+    // Разбор строки форматом и вызов его обработчика; false, если строка не совпала с форматом.
+    using route = std::move_only_function<bool(std::string_view)>;
+
+    std::uint32_t child(std::uint32_t parent, char symbol) const noexcept {
+        const auto& children = nodes_[parent].children;
+        const auto it        = std::ranges::lower_bound(children, symbol, {}, &edge::symbol);
+        return it != children.end() && it->symbol == symbol ? it->target : no_node;
+    }
+
+    std::uint32_t insert(std::string_view prefix) {
+        std::uint32_t node = 0;
+        for(char symbol : prefix) {
+            auto next = child(node, symbol);
+            if(next == no_node) {
+                next = static_cast<std::uint32_t>(nodes_.size());
+                nodes_.emplace_back();
+                auto& children = nodes_[node].children;
+                children.insert(std::ranges::lower_bound(children, symbol, {}, &edge::symbol), edge {symbol, next});
+            }
+            node = next;
+        }
+        return node;
+    }
+
+    // Пересчёт ссылок на ближайших предков с форматами. Выполняется при добавлении формата, а не при разборе строк.
+    void link_fallbacks() {
+        auto visit = [&](auto& self, std::uint32_t current, std::uint32_t nearest) -> void {
+            nodes_[current].fallback = nearest;
+            const auto below         = nodes_[current].routes.empty() ? nearest : current;
+            for(const auto& e : nodes_[current].children) {
+                self(self, e.target, below);
+            }
+        };
+        visit(visit, 0, no_node);
+    }
+
+    std::vector<node> nodes_;
+    std::vector<route> routes_;
+};
+
+}  // namespace stdx
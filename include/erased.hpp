@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "config.hpp"
+#include "parse.hpp"
+#include "stats.hpp"
+#include "types.hpp"
+
+// Компактный бэкенд scan по runtime-формату включается определением STDX_SCAN_ERASED=1 (опция CMake
+// STDX_SCAN_ERASED). Тогда scan<Ts...>(input, format) для сигнатур из поддерживаемых типов идёт через scan_compact:
+// результат и ошибки те же, но код на каждую сигнатуру сводится к заполнению двух массивов. Значение макроса входит
+// в имена типов библиотеки (см. config.hpp).
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
+
+// Тип назначения поля в компактном бэкенде: вид значения и его ширина.
+enum class erased_type : unsigned char {
+    i8,           // signed char
+    u8,           // unsigned char
+    i16,          // short int
+    u16,          // unsigned short int
+    i32,          // int
+    u32,          // unsigned int
+    i64,          // long long int
+    u64,          // unsigned long long int
+    f32,          // float
+    f64,          // double
+    string,       // std::string
+    pmr_string,   // std::pmr::string
+    string_view,  // std::string_view
+    c_string,     // const char*
+    skip,         // stdx::skip
+    none,         // Тип не поддерживается компактным бэкендом.
+};
+
+template<typename T> constexpr erased_type erased_type_of() {
+    if constexpr(std::same_as<T, signed char>) {
+        return erased_type::i8;
+    }
+    else if constexpr(std::same_as<T, unsigned char>) {
+        return erased_type::u8;
+    }
+    else if constexpr(std::same_as<T, short int>) {
+        return erased_type::i16;
+    }
+    else if constexpr(std::same_as<T, unsigned short int>) {
+        return erased_type::u16;
+    }
+    else if constexpr(std::same_as<T, int>) {
+        return erased_type::i32;
+    }
+    else if constexpr(std::same_as<T, unsigned int>) {
+        return erased_type::u32;
+    }
+    else if constexpr(std::same_as<T, long long int>) {
+        return erased_type::i64;
+    }
+    else if constexpr(std::same_as<T, unsigned long long int>) {
+        return erased_type::u64;
+    }
+    else if constexpr(std::same_as<T, float>) {
+        return erased_type::f32;
+    }
+    else if constexpr(std::same_as<T, double>) {
+        return erased_type::f64;
+    }
+    else if constexpr(is_string<T>) {
+        return erased_type::string;
+    }
+    else if constexpr(is_pmr_string<T>) {
+        return erased_type::pmr_string;
+    }
+    else if constexpr(is_string_view<T>) {
+        return erased_type::string_view;
+    }
+    else if constexpr(is_c_string<T>) {
+        return erased_type::c_string;
+    }
+    else if constexpr(std::same_as<T, skip>) {
+        return erased_type::skip;
+    }
+    else {
+        return erased_type::none;
+    }
+}
+
+// Сигнатура, все типы которой есть в таблице конвертеров.
+template<typename... Ts>
+concept is_erasable = ((erased_type_of<Ts>() != erased_type::none) && ...);
+
+using erased_converter = std::expected<void, scan_error> (*)(std::string_view input, spec_kind kind, void* out);
+
+// Конвертер в тип T через стёртый указатель. Экземпляр один на тип назначения во всей программе и общий для всех
+// сигнатур, поэтому ветви разбора и тексты ошибок типа не копируются в код каждой сигнатуры.
+template<typename T> std::expected<void, scan_error> erased_convert(std::string_view input, spec_kind kind, void* out) {
+    return convert_into(input, kind, *static_cast<T*>(out));
+}
+
+// Таблица конвертеров, индексируемая erased_type.
+inline constexpr std::array<erased_converter, static_cast<std::size_t>(erased_type::none)> erased_converters {
+    &erased_convert<signed char>,
+    &erased_convert<unsigned char>,
+    &erased_convert<short int>,
+    &erased_convert<unsigned short int>,
+    &erased_convert<int>,
+    &erased_convert<unsigned int>,
+    &erased_convert<long long int>,
+    &erased_convert<unsigned long long int>,
+    &erased_convert<float>,
+    &erased_convert<double>,
+    &erased_convert<std::string>,
+    &erased_convert<std::pmr::string>,
+    &erased_convert<std::string_view>,
+    &erased_convert<const char*>,
+    &erased_convert<skip>,
+};
+
+// Ядро компактного бэкенда с той же семантикой, что и у scan_to: разбор формата, сопоставление литералов
+// и конверсия каждого поля через таблицу. Шаблон зависит только от числа полей N, поэтому его экземпляры
+// общие для всех сигнатур одной длины.
+template<std::size_t N>
+std::expected<void, scan_error> scan_erased(std::string_view input, std::string_view format,
+                                            const std::array<erased_type, N>& types,
+                                            const std::array<void*, N>& fields) {
+    scan_probe probe(format, input.size());
+    auto parsed = parse_sources<N>(input, format);
+    if(!parsed) {
+        probe.failed(parsed.error(), true);
+        return std::unexpected(std::move(parsed.error()));
+    }
+
+    const auto& [fmt, data] = parsed.value();
+    if(fmt.size() != N) {
+        scan_error error(scan_errc::mismatched_count);
+        probe.failed(error, true);
+        return std::unexpected(std::move(error));
+    }
+    probe.matched();
+
+    for(std::size_t i = 0; i < N; ++i) {
+        scan_error error;
+        if(i >= data.size()) {
+            error = scan_error(scan_errc::index_out_of_bounds);
+        }
+        else if(auto kind = parse_spec(fmt[i]); !kind) {
+            error = format_issue_error(kind.error());
+        }
+        else {
+            const auto convert = erased_converters[static_cast<std::size_t>(types[i])];
+            auto converted     = convert(data[i], kind.value(), fields[i]);
+            if(converted) {
+                continue;
+            }
+            error = std::move(locate_field(converted.error(), i, input, data[i]));
+        }
+        probe.failed(error, false);
+        return std::unexpected(std::move(error));
+    }
+    probe.succeeded();
+    return {};
+}
+
+// Тонкий слой сигнатуры: типы полей кодируются байтами erased_type, а значения передаются стёртыми указателями.
+template<typename... Ts>
+    requires is_erasable<Ts...>
+std::expected<void, scan_error> scan_to_erased(std::string_view input, std::string_view format,
+                                               scan_result<Ts...>& scanResult) {
+    static constexpr std::array<erased_type, sizeof...(Ts)> types {erased_type_of<Ts>()...};
+    auto fields = std::apply([](auto&... values) { return std::array<void*, sizeof...(Ts)> {&values...}; },
+                             scanResult.result);
+    return scan_erased<sizeof...(Ts)>(input, format, types, fields);
+}
+
+}  // namespace stdx::details
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Сканирование по runtime-формату через таблицу конвертеров. Результат и ошибки совпадают со scan, а машинного кода
+// на каждую новую сигнатуру Ts... почти нет: это полезно, когда сигнатур сотни и код scan вытесняет из кэша
+// инструкций горячий путь.
+template<typename... Ts>
+    requires details::is_erasable<Ts...>
+std::expected<details::scan_result<Ts...>, details::scan_error> scan_compact(std::string_view input,
+                                                                             std::string_view format) {
+    details::scan_result<Ts...> scanResult;
+    if(auto scanned = details::scan_to_erased<Ts...>(input, format, scanResult); !scanned) {
+        return std::unexpected(std::move(scanned.error()));
+    }
+    return scanResult;
+}
+
+// Перегрузка scan_compact с ресурсом памяти для полей std::pmr::string.
+template<typename... Ts>
+    requires details::is_erasable<Ts...>
+std::expected<details::scan_result<Ts...>, details::scan_error>
+scan_compact(std::string_view input, std::string_view format, std::pmr::memory_resource* resource) {
+    auto scanResult = details::make_scan_result<Ts...>(resource);
+    if(auto scanned = details::scan_to_erased<Ts...>(input, format, scanResult); !scanned) {
+        return std::unexpected(std::move(scanned.error()));
+    }
+    return scanResult;
+}
+
+}  // namespace stdx
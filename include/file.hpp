@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "lines.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+using namespace std::literals;
+
+// Файл, отображённый в память только для чтения. Владеет отображением и освобождает его в деструкторе.
+class mapped_file {
+public:
+    // Отображение файла в память с подсказкой ядру о последовательном чтении.
+    static std::expected<mapped_file, details::scan_error> open(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd == -1) {
+            return std::unexpected(details::scan_error(details::scan_errc::file_open_failed, path.string()));
+        }
+
+        struct stat status {};
+        if(::fstat(fd, &status) == -1) {
+            ::close(fd);
+            return std::unexpected(details::scan_error(details::scan_errc::file_stat_failed, path.string()));
+        }
+
+        mapped_file file;
+        file.size_ = static_cast<std::size_t>(status.st_size);
+        // Пустой файл отобразить нельзя, поэтому для него остаётся пустое представление.
+        if(file.size_ != 0) {
+            void* data = ::mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data == MAP_FAILED) {
+                ::close(fd);
+                return std::unexpected(details::scan_error(details::scan_errc::file_map_failed, path.string()));
+            }
+            ::madvise(data, file.size_, MADV_SEQUENTIAL);
+            file.data_ = static_cast<const char*>(data);
+        }
+        // Отображение остаётся действительным и после закрытия дескриптора.
+        ::close(fd);
+        return file;
+    }
+
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept :
+        data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if(this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        unmap();
+    }
+
+    std::string_view view() const noexcept {
+        return {data_, size_};
+    }
+
+private:
+    mapped_file() = default;
+
+    void unmap() noexcept {
+        if(data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Диапазон результатов построчного сканирования отображённого в память файла. Владеет отображением, поэтому поля
+// std::string_view в результатах указывают прямо в него и действительны, пока жив сам диапазон.
+template<typename... Ts> class file_scan {
+public:
+    using value_type = std::expected<details::scan_result<Ts...>, details::scan_error>;
+
+    class iterator {
+    public:
+        using value_type      = file_scan::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        const value_type& operator*() const noexcept {
+            return current_;
+        }
+
+        const value_type* operator->() const noexcept {
+            return &current_;
+        }
+
+        iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        void operator++(int) {
+            advance();
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+            return it.done_;
+        }
+
+    private:
+        friend class file_scan;
+
+        explicit iterator(const file_scan* owner) : owner_(owner) {
+            advance();
+        }
+
+        // Переход к следующей строке файла и её сканирование.
+        void advance() {
+            auto source = owner_->source();
+            if(position_ >= source.size()) {
+                done_ = true;
+                return;
+            }
+            current_ = owner_->pattern_.scan(details::next_line(source, position_));
+        }
+
+        const file_scan* owner_ = nullptr;
+        std::size_t position_   = 0;
+        bool done_              = false;
+        value_type current_ {};
+    };
+
+    file_scan(mapped_file file, scan_pattern<Ts...> pattern) :
+        file_(std::move(file)), pattern_(std::move(pattern)) {}
+
+    iterator begin() const {
+        return iterator {this};
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return {};
+    }
+
+    // Содержимое файла целиком.
+    std::string_view source() const noexcept {
+        return file_.view();
+    }
+
+private:
+    mapped_file file_;
+    scan_pattern<Ts...> pattern_;
+};
+
+// Построчное сканирование файла без копирования: файл отображается в память, а каждая строка сканируется по
+// скомпилированному один раз шаблону.
+template<typename... Ts>
+std::expected<file_scan<Ts...>, details::scan_error> scan_file(const std::filesystem::path& path,
+                                                               std::string_view format) {
+    auto pattern = scan_pattern<Ts...>::compile(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    auto file = mapped_file::open(path);
+    if(!file) {
+        return std::unexpected(std::move(file.error()));
+    }
+    return file_scan<Ts...> {std::move(file.value()), std::move(pattern.value())};
+}
+
+}  // namespace stdx
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "config.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
+
+// Чтение 8 байт как little-endian числа: первый символ оказывается в младшем байте.
+constexpr std::uint64_t load_eight_chars(const char* p) noexcept {
+    if !consteval {
+        if constexpr(std::endian::native == std::endian::little) {
+            std::uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            return word;
+        }
+    }
+    std::uint64_t word = 0;
+    for(int i = 7; i >= 0; --i) {
+        word = (word << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return word;
+}
+
+// Число ведущих байтов-цифр в 8-байтовом слове (SWAR: проверка всех байтов одновременно).
+constexpr unsigned leading_digits(std::uint64_t word) noexcept {
+    // Байт - цифра, если его старшая тетрада равна 3, а прибавление 6 не выводит его за '9'.
+    const std::uint64_t not_digits =
+        ((word & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) ^
+                                                               0x3030303030303030);
+    return not_digits == 0 ? 8u : static_cast<unsigned>(std::countr_zero(not_digits)) / 8;
+}
+
+// Значение 8 цифр, уже проверенных leading_digits, за три умножения (SWAR).
+constexpr std::uint32_t eight_digits_value(std::uint64_t word) noexcept {
+    word = (word & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+    word = (word & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+    return static_cast<std::uint32_t>((word & 0x0000FFFF0000FFFF) * 42949672960001 >> 32);
+}
+
+// Степени десяти, помещающиеся в std::uint64_t.
+inline constexpr std::uint64_t powers_of_ten[] = {1,
+                                                  10,
+                                                  100,
+                                                  1'000,
+                                                  10'000,
+                                                  100'000,
+                                                  1'000'000,
+                                                  10'000'000,
+                                                  100'000'000,
+                                                  1'000'000'000,
+                                                  10'000'000'000,
+                                                  100'000'000'000,
+                                                  1'000'000'000'000};
+
+// Разбор десятичного целого по 8 цифр за шаг сразу в тип T. Контракт совпадает с std::from_chars(first, last, value)
+// для base = 10: знак '-' допустим только для знаковых T, '+' не допускается, поглощаются все цифры подряд, при
+// переполнении возвращается std::errc::result_out_of_range, а value остаётся неизменным.
+template<typename T>
+    requires std::is_integral_v<T>
+constexpr std::from_chars_result parse_integer(const char* first, const char* last, T& value) noexcept {
+    const char* p = first;
+    bool negative = false;
+    if constexpr(std::is_signed_v<T>) {
+        if(p != last && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+    const char* digits = p;
+
+    std::uint64_t magnitude = 0;
+    bool overflow           = false;
+    while(last - p >= 8) {
+        const auto word  = load_eight_chars(p);
+        const auto count = leading_digits(word);
+        if(count == 0) {
+            break;
+        }
+        // Неполный блок сдвигается к старшим байтам: освободившиеся нулевые байты читаются как ведущие нули.
+        const auto value = eight_digits_value(count == 8 ? word : word << (64 - 8 * count));
+        overflow |= __builtin_mul_overflow(magnitude, powers_of_ten[count], &magnitude);
+        overflow |= __builtin_add_overflow(magnitude, std::uint64_t {value}, &magnitude);
+        p += count;
+        if(count != 8) {
+            break;
+        }
+    }
+    // Хвост короче 8 байт содержит не больше 7 цифр, поэтому при небольшом накопленном значении переполнение
+    // невозможно и проверки не нужны.
+    if(magnitude < powers_of_ten[12]) {
+        for(; p != last && static_cast<unsigned char>(*p - '0') < 10; ++p) {
+            magnitude = magnitude * 10 + static_cast<std::uint64_t>(*p - '0');
+        }
+    }
+    else {
+        for(; p != last && static_cast<unsigned char>(*p - '0') < 10; ++p) {
+            overflow |= __builtin_mul_overflow(magnitude, std::uint64_t {10}, &magnitude);
+            overflow |= __builtin_add_overflow(magnitude, static_cast<std::uint64_t>(*p - '0'), &magnitude);
+        }
+    }
+
+    if(p == digits) {
+        return {first, std::errc::invalid_argument};
+    }
+
+    using unsigned_t          = std::make_unsigned_t<T>;
+    const std::uint64_t max   = static_cast<unsigned_t>(std::numeric_limits<T>::max());
+    const std::uint64_t limit = negative ? max + 1 : max;  // |min| для знаковых T на единицу больше max.
+    if(overflow || magnitude > limit) {
+        return {p, std::errc::result_out_of_range};
+    }
+
+    if constexpr(std::is_signed_v<T>) {
+        // Отрицание в беззнаковой арифметике корректно и для |min|.
+        value = negative ? static_cast<T>(static_cast<unsigned_t>(0u - magnitude)) : static_cast<T>(magnitude);
+    }
+    else {
+        value = static_cast<T>(magnitude);
+    }
+    return {p, std::errc {}};
+}
+
+}  // namespace stdx::details
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "config.hpp"
+#include "cache.hpp"
+#include "decimal.hpp"
+#include "parse.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+namespace details {
+
+// Типы, которые scan конвертирует как одно поле. Остальные агрегаты раскладываются на члены.
+template<typename T>
+concept is_field_type = is_integral<T> || is_floating<T> || is_decimal<T> || is_c_string<T> || is_string<T> ||
+                        is_pmr_string<T> || is_string_view<T> || std::same_as<std::remove_cv_t<T>, skip>;
+
+// Заглушка, приводимая к любому типу: используется только в невычисляемом контексте для подсчёта членов агрегата.
+struct any_member {
+    template<typename U> operator U() const;
+};
+
+template<typename T, std::size_t... Ids> constexpr bool brace_constructible(std::index_sequence<Ids...>) {
+    return requires { T {(static_cast<void>(Ids), any_member {})...}; };
+}
+
+inline constexpr std::size_t max_aggregate_members = 16;
+
+// Число значений, которыми инициализируется агрегат T: наибольшее N, при котором T {v1, ..., vN} корректно. Подсчёт
+// идёт до max_aggregate_members + 1, чтобы агрегат с лишними членами был отвергнут, а не разобран частично.
+template<typename T> constexpr std::size_t aggregate_arity() {
+    std::size_t arity = 0;
+    [&]<std::size_t... Ns>(std::index_sequence<Ns...>) {
+        ((brace_constructible<T>(std::make_index_sequence<Ns>()) ? arity = Ns : arity), ...);
+    }(std::make_index_sequence<max_aggregate_members + 2>());
+    return arity;
+}
+
+template<typename T, std::size_t... Before, std::size_t... After>
+constexpr bool brace_constructible_around(std::index_sequence<Before...>, std::index_sequence<After...>) {
+    return requires {
+        T {(static_cast<void>(Before), any_member {})..., {}, (static_cast<void>(After), any_member {})...};
+    };
+}
+
+// Соответствует ли каждое из Arity значений отдельному члену T. Член-массив any_member не инициализирует, и по
+// правилу brace elision значения уходят в элементы массива, поэтому aggregate_arity считает их как отдельные члены.
+// Пустой список {} вместо одного из значений всегда инициализирует член целиком: на месте первого элемента массива
+// он забирает весь массив, и оставшихся значений оказывается больше, чем членов.
+template<typename T, std::size_t Arity> constexpr bool members_are_direct() {
+    return []<std::size_t... Ids>(std::index_sequence<Ids...>) {
+        return (brace_constructible_around<T>(std::make_index_sequence<Ids>(),
+                                              std::make_index_sequence<Arity - 1 - Ids>()) &&
+                ...);
+    }(std::make_index_sequence<Arity>());
+}
+
+// Член агрегата, который нельзя сопоставить одному плейсхолдеру: C-массив или вложенный агрегат.
+template<typename M>
+concept is_nested_member = std::is_array_v<std::remove_reference_t<M>> ||
+                           (std::is_aggregate_v<std::remove_cvref_t<M>> && !is_field_type<std::remove_cvref_t<M>>);
+
+template<typename Tuple> constexpr bool has_nested_members = false;
+
+template<typename... Ms> constexpr bool has_nested_members<std::tuple<Ms...>> = (is_nested_member<Ms> || ...);
+
+template<typename T>
+concept is_scan_aggregate = std::is_aggregate_v<T> && !std::is_array_v<T> && !is_field_type<T> &&
+                            aggregate_arity<T>() > 0;
+
+// Кортеж ссылок на Arity членов агрегата в порядке объявления. Структурное связывание требует точного числа имён,
+// поэтому для каждого числа членов есть своя ветвь; их число ограничено max_aggregate_members.
+template<std::size_t Arity, typename T> constexpr auto tie_exactly(T& value) {
+    static_assert(Arity >= 1 && Arity <= max_aggregate_members);
+    if constexpr(Arity == 1) {
+        auto& [m1] = value;
+        return std::tie(m1);
+    }
+    else if constexpr(Arity == 2) {
+        auto& [m1, m2] = value;
+        return std::tie(m1, m2);
+    }
+    else if constexpr(Arity == 3) {
+        auto& [m1, m2, m3] = value;
+        return std::tie(m1, m2, m3);
+    }
+    else if constexpr(Arity == 4) {
+        auto& [m1, m2, m3, m4] = value;
+        return std::tie(m1, m2, m3, m4);
+    }
+    else if constexpr(Arity == 5) {
+        auto& [m1, m2, m3, m4, m5] = value;
+        return std::tie(m1, m2, m3, m4, m5);
+    }
+    else if constexpr(Arity == 6) {
+        auto& [m1, m2, m3, m4, m5, m6] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6);
+    }
+    else if constexpr(Arity == 7) {
+        auto& [m1, m2, m3, m4, m5, m6, m7] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7);
+    }
+    else if constexpr(Arity == 8) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8);
+    }
+    else if constexpr(Arity == 9) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9);
+    }
+    else if constexpr(Arity == 10) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+    }
+    else if constexpr(Arity == 11) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+    }
+    else if constexpr(Arity == 12) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+    }
+    else if constexpr(Arity == 13) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+    }
+    else if constexpr(Arity == 14) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+    }
+    else if constexpr(Arity == 15) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+    }
+    else {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16] = value;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16);
+    }
+}
+
+// Кортеж ссылок на члены агрегата в порядке объявления. Каждый член должен быть одним полем сканирования: агрегаты
+// с C-массивами, вложенными агрегатами или более чем max_aggregate_members членами отвергаются при компиляции.
+template<is_scan_aggregate T> constexpr auto tie_members(T& value) {
+    constexpr std::size_t arity = aggregate_arity<T>();
+    constexpr bool fits         = arity <= max_aggregate_members;
+    constexpr bool direct       = fits && members_are_direct<T, arity>();
+    static_assert(fits, "scan_into supports aggregates with at most 16 members");
+    static_assert(!fits || direct, "scan_into does not support C-array members of aggregates");
+    if constexpr(direct) {
+        auto members = tie_exactly<arity>(value);
+        static_assert(!has_nested_members<decltype(members)>,
+                      "scan_into does not support C-array or nested aggregate members of aggregates");
+        return members;
+    }
+    else {
+        return std::tuple<> {};
+    }
+}
+
+// Конверсия выделенных полей прямо в объекты out...
+template<typename... Ts>
+std::expected<void, scan_error> convert_fields_into(std::string_view input,
+                                                    const std::array<std::string_view, sizeof...(Ts)>& fields,
+                                                    const std::array<spec_kind, sizeof...(Ts)>& kinds, Ts&... out) {
+    scan_error error;
+    auto convert = [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+        auto one = [&]<std::size_t I, typename T>(T& value) {
+            auto converted = convert_into(fields[I], kinds[I], value);
+            if(!converted) {
+                error = std::move(locate_field(converted.error(), I, input, fields[I]));
+                return false;
+            }
+            return true;
+        };
+        return (one.template operator()<Ids>(out) && ...);
+    };
+    if(!convert(std::index_sequence_for<Ts...> {})) {
+        return std::unexpected(std::move(error));
+    }
+    return {};
+}
+
+}  // namespace details
+
+// Сканирование по скомпилированному шаблону прямо в объекты out... тех же типов, что и поля шаблона. Строки
+// заполняются через assign, поэтому std::string, переиспользуемая между вызовами, сохраняет свой буфер и при
+// достаточной ёмкости не выделяет память. При ошибке конверсии поля до ошибочного уже записаны, а остальные
+// не изменены.
+template<typename... Ts>
+    requires(sizeof...(Ts) > 0)
+std::expected<void, details::scan_error> scan_into(std::string_view input, const scan_pattern<Ts...>& pattern,
+                                                   Ts&... out) {
+    std::array<std::string_view, sizeof...(Ts)> fields;
+    if(auto matched = pattern.match(input, fields); !matched) {
+        return std::unexpected(std::move(matched.error()));
+    }
+    std::array<details::spec_kind, sizeof...(Ts)> kinds;
+    for(std::size_t i = 0; i < kinds.size(); ++i) {
+        kinds[i] = pattern.kind(i);
+    }
+    return details::convert_fields_into(input, fields, kinds, out...);
+}
+
+// Сканирование по runtime-формату прямо в объекты out... Формат компилируется один раз и берётся из format_cache,
+// поэтому повторные вызовы не разбирают его заново.
+template<typename... Ts>
+    requires(sizeof...(Ts) > 0)
+std::expected<void, details::scan_error> scan_into(std::string_view input, std::string_view format, Ts&... out) {
+    auto pattern = format_cache<Ts...>::instance().find(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return scan_into(input, *pattern.value(), out...);
+}
+
+// Сканирование в члены агрегата: плейсхолдеры формата сопоставляются членам в порядке их объявления.
+template<details::is_scan_aggregate T>
+std::expected<void, details::scan_error> scan_into(std::string_view input, std::string_view format, T& out) {
+    return std::apply([&](auto&... members) { return scan_into(input, format, members...); },
+                      details::tie_members(out));
+}
+
+// Сканирование по скомпилированному шаблону в члены агрегата с теми же типами, что и поля шаблона.
+template<details::is_scan_aggregate T, typename... Ts>
+std::expected<void, details::scan_error> scan_into(std::string_view input, const scan_pattern<Ts...>& pattern,
+                                                   T& out) {
+    return std::apply([&](auto&... members) { return scan_into(input, pattern, members...); },
+                      details::tie_members(out));
+}
+
+}  // namespace stdx
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "config.hpp"
+#include "parse.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Запись отложенного сканирования: при сканировании выделяются только границы полей, а поле I конвертируется при
+// первом обращении get<I>() и запоминается. Запрос, читающий два поля из пятнадцати, платит только за их конверсию.
+// Поля указывают во входную строку, поэтому запись действительна, пока жив буфер source(). Кэш конверсий не
+// синхронизирован: одну запись не следует читать из нескольких потоков одновременно.
+template<typename... Ts> class lazy_record {
+public:
+    static constexpr std::size_t fields_count = sizeof...(Ts);
+
+    template<std::size_t I> using field_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    // Запись создаётся функциями scan_lazy из уже сопоставленных границ полей.
+    lazy_record(std::string_view source, const std::array<std::string_view, fields_count>& fields,
+                const std::array<details::spec_kind, fields_count>& kinds) :
+        source_(source), fields_(fields), kinds_(kinds) {}
+
+    // Значение поля I, сконвертированное при первом обращении. Ошибка конверсии также запоминается и содержит
+    // индекс поля и его смещение во входной строке.
+    template<std::size_t I> const std::expected<field_type<I>, details::scan_error>& get() const {
+        static_assert(I < fields_count, "field index out of range");
+        auto& cached = std::get<I>(cache_);
+        if(!cached) {
+            cached.emplace(details::convert_value<field_type<I>>(fields_[I], kinds_[I]));
+            if(!cached->has_value()) {
+                details::locate_field(cached->error(), I, source_, fields_[I]);
+            }
+        }
+        return *cached;
+    }
+
+    // Текст поля i без конверсии.
+    std::string_view field(std::size_t i) const noexcept {
+        return fields_[i];
+    }
+
+    // Было ли поле I уже сконвертировано.
+    template<std::size_t I> bool converted() const noexcept {
+        return std::get<I>(cache_).has_value();
+    }
+
+    std::string_view source() const noexcept {
+        return source_;
+    }
+
+private:
+    std::string_view source_;
+    std::array<std::string_view, fields_count> fields_;
+    std::array<details::spec_kind, fields_count> kinds_;
+    mutable std::tuple<std::optional<std::expected<Ts, details::scan_error>>...> cache_ {};
+};
+
+// Отложенное сканирование по форматной строке: формат разбирается и проверяется на соответствие Ts... сразу,
+// а конверсия полей откладывается до обращения к ним.
+template<typename... Ts>
+std::expected<lazy_record<Ts...>, details::scan_error> scan_lazy(std::string_view input, std::string_view format) {
+    constexpr std::size_t fields_count = sizeof...(Ts);
+    auto layout                        = details::compile_layout<fields_count>(format);
+    if(!layout) {
+        return std::unexpected(details::format_issue_error(layout.error()));
+    }
+
+    details::scan_error error;
+    auto check_fields = [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+        auto check = [&]<typename T>(std::size_t i) {
+            if(!details::is_spec_compatible<T>(layout->entries[i].kind)) {
+                error = details::spec_mismatch_error<T>(layout->entries[i].kind);
+                return false;
+            }
+            return true;
+        };
+        return (check.template operator()<Ts>(Ids) && ...);
+    };
+    if(!check_fields(std::index_sequence_for<Ts...> {})) {
+        return std::unexpected(std::move(error));
+    }
+
+    std::array<std::string_view, fields_count> fields;
+    if(auto matched = details::match_fields(input, format, layout.value(), fields); !matched) {
+        return std::unexpected(std::move(matched.error()));
+    }
+    return lazy_record<Ts...> {input, fields, layout->kinds()};
+}
+
+// Отложенное сканирование по скомпилированному шаблону.
+template<typename... Ts>
+std::expected<lazy_record<Ts...>, details::scan_error> scan_lazy(std::string_view input,
+                                                                 const scan_pattern<Ts...>& pattern) {
+    std::array<std::string_view, sizeof...(Ts)> fields;
+    if(auto matched = pattern.match(input, fields); !matched) {
+        return std::unexpected(std::move(matched.error()));
+    }
+    std::array<details::spec_kind, sizeof...(Ts)> kinds;
+    for(std::size_t i = 0; i < kinds.size(); ++i) {
+        kinds[i] = pattern.kind(i);
+    }
+    return lazy_record<Ts...> {input, fields, kinds};
+}
+
+// Временная std::string умрёт раньше записи, поэтому отложенное сканирование из неё запрещено.
+template<typename... Ts, typename S, typename Format>
+    requires std::same_as<S, std::string>
+void scan_lazy(S&& input, const Format& format) = delete;
+
+}  // namespace stdx
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "config.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
+
+// Выделение очередной строки buffer, начинающейся с position, и перевод position за её завершающий '\n'. Последняя
+// строка может не завершаться '\n'; вызывающий код продолжает, пока position < buffer.size(), поэтому завершающий
+// '\n' буфера не порождает пустую строку.
+constexpr std::string_view next_line(std::string_view buffer, std::size_t& position) noexcept {
+    auto end = buffer.find('\n', position);
+    if(end == std::string_view::npos) {
+        end = buffer.size();
+    }
+    auto line = buffer.substr(position, end - position);
+    position  = end + 1;
+    return line;
+}
+
+}  // namespace stdx::details
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "lines.hpp"
+#include "parse.hpp"
+#include "search.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Глубина проверки строки без конверсии полей.
+enum class match_mode : unsigned char {
+    structure,  // Только литералы формата и ширины полей.
+    lexical,    // Дополнительно начало значений: запись числа для {%d}, {%u} и {%f}, как при конверсии в scan.
+};
+
+namespace details {
+
+constexpr bool is_digit(char symbol) noexcept {
+    return symbol >= '0' && symbol <= '9';
+}
+
+// Лексическая проверка повторяет правило конверсии: scan разбирает числа через from_chars и принимает поле, если
+// число записано в его начале, а остаток поля игнорирует. Поэтому проверяется только начало значения. Диапазон
+// типа не проверяется: без типов полей он неизвестен.
+
+// Начало записи целого числа: цифра, для {%d} возможно после '-' (как у parse_integer, '+' не допускается).
+constexpr bool looks_integral(std::string_view value, bool allow_minus) noexcept {
+    if(allow_minus && value.starts_with('-')) {
+        value.remove_prefix(1);
+    }
+    return !value.empty() && is_digit(value.front());
+}
+
+// Начало записи числа с плавающей точкой, которое принимает std::from_chars: [-], затем цифра, '.' с цифрой или
+// inf/nan без учёта регистра. Экспонента и всё после мантиссы на ответ не влияют: без них число всё равно разобрано.
+constexpr bool looks_floating(std::string_view value) noexcept {
+    if(value.starts_with('-')) {
+        value.remove_prefix(1);
+    }
+    auto starts_ignore_case = [&](std::string_view word) {
+        return value.size() >= word.size() &&
+               std::ranges::equal(value.substr(0, word.size()), word,
+                                  [](char symbol, char expected) { return (symbol | 0x20) == expected; });
+    };
+    if(starts_ignore_case("inf") || starts_ignore_case("nan")) {
+        return true;
+    }
+    if(value.starts_with('.')) {
+        value.remove_prefix(1);
+    }
+    return !value.empty() && is_digit(value.front());
+}
+
+// Лексическая проверка значения поля по виду спецификатора. Поля {}, {%s} и {*} принимают любой текст.
+constexpr bool looks_like(std::string_view value, spec_kind kind) noexcept {
+    switch(kind) {
+        case spec_kind::integral:
+            return looks_integral(value, true);
+        case spec_kind::natural:
+            return looks_integral(value, false);
+        case spec_kind::floating:
+            return looks_floating(value);
+        case spec_kind::empty:
+        case spec_kind::string:
+        case spec_kind::skip:
+            return true;
+    }
+    return true;
+}
+
+}  // namespace details
+
+// Скомпилированный формат для проверки строк без конверсии и без типов полей: ответ только "совпала или нет". Число
+// плейсхолдеров не фиксировано при компиляции программы, поэтому описание формата хранится в векторе.
+class scan_matcher {
+public:
+    // Разбор форматной строки по тем же правилам, что и в scan_pattern::compile, но без сверки с типами.
+    static std::expected<scan_matcher, details::scan_error> compile(std::string_view format,
+                                                                    match_mode mode = match_mode::structure) {
+        scan_matcher matcher;
+        matcher.format_ = format;
+        matcher.mode_   = mode;
+
+        std::size_t start = 0;
+        while(true) {
+            std::size_t open = format.find('{', start);
+            if(open == std::string_view::npos) {
+                break;
+            }
+            std::size_t close = format.find('}', open);
+            if(close == std::string_view::npos) {
+                break;
+            }
+            if(!matcher.fields_.empty() && open == start && matcher.fields_.back().width == 0) {
+                return std::unexpected(details::format_issue_error(details::format_issue::adjacent_placeholders));
+            }
+            auto spec = format.substr(open + 1, close - open - 1);
+            auto kind = details::parse_spec(spec);
+            if(!kind) {
+                return std::unexpected(details::format_issue_error(kind.error()));
+            }
+            matcher.fields_.push_back({{start, open - start},
+                                       details::plan_literal(format.substr(start, open - start)),
+                                       kind.value(),
+                                       details::spec_width(spec)});
+            start = close + 1;
+        }
+        matcher.fixed_ = !matcher.fields_.empty() && std::ranges::all_of(matcher.fields_, [](const auto& entry) {
+                             return entry.width != 0;
+                         });
+        // Хвостовой литерал - последняя запись, как в format_layout.
+        matcher.fields_.push_back({{start, format.size() - start}, details::plan_literal(format.substr(start))});
+
+        matcher.multiline_ = format.find('\n') != std::string_view::npos;
+        // Опорный литерал для пропуска строк в for_each_match: самый длинный, то есть самый избирательный.
+        matcher.anchor_ = matcher.fields_.back();
+        for(const auto& entry : matcher.fields_) {
+            if(entry.literal.length > matcher.anchor_.literal.length) {
+                matcher.anchor_ = entry;
+            }
+        }
+        return matcher;
+    }
+
+    // Совпадает ли строка с форматом. Границы полей находятся тем же обходом, что и в scan, поэтому строка, прошедшая
+    // проверку в режиме structure, даёт при сканировании ошибку только конверсии значения.
+    bool matches(std::string_view input) const {
+        bool plausible = true;
+        auto check     = [&](std::size_t i, std::string_view value) {
+            if(mode_ == match_mode::lexical) {
+                plausible = plausible && details::looks_like(value, fields_[i].kind);
+            }
+        };
+        return details::walk_fields(input, format_, fields_, fixed_, details::input_finder {}, check).has_value() &&
+               plausible;
+    }
+
+    // Вызов on_match(offset, line) для каждой совпавшей строки буфера с записями, разделёнными '\n'. Строка без
+    // самого длинного литерала формата совпасть не может, поэтому буфер просматривается поиском этого литерала,
+    // а строки между вхождениями пропускаются целиком, без построчной обработки.
+    template<typename OnMatch> void for_each_match(std::string_view buffer, OnMatch&& on_match) const {
+        std::size_t position = 0;
+        auto anchor          = literal(anchor_.literal);
+        if(anchor.empty() || multiline_) {
+            while(position < buffer.size()) {
+                std::size_t start = position;
+                auto line         = details::next_line(buffer, position);
+                if(matches(line)) {
+                    on_match(start, line);
+                }
+            }
+            return;
+        }
+
+        while(position < buffer.size()) {
+            auto hit = details::find_literal_linear(buffer.substr(position), anchor, anchor_.plan);
+            if(hit == std::string_view::npos) {
+                return;
+            }
+            hit += position;
+            std::size_t start = position;
+            if(auto newline = buffer.substr(position, hit - position).rfind('\n');
+               newline != std::string_view::npos) {
+                start += newline + 1;
+            }
+            auto end = buffer.find('\n', hit);
+            if(end == std::string_view::npos) {
+                end = buffer.size();
+            }
+            if(auto line = buffer.substr(start, end - start); matches(line)) {
+                on_match(start, line);
+            }
+            position = end + 1;
+        }
+    }
+
+    std::string_view format() const noexcept {
+        return format_;
+    }
+
+    std::size_t fields_count() const noexcept {
+        return fields_.size() - 1;
+    }
+
+    match_mode mode() const noexcept {
+        return mode_;
+    }
+
+private:
+    scan_matcher() = default;
+
+    std::string_view literal(details::segment item) const noexcept {
+        return std::string_view {format_}.substr(item.offset, item.length);
+    }
+
+    std::string format_;
+    std::vector<details::field_entry> fields_;  // Поля формата и хвостовой литерал последней записью.
+    details::field_entry anchor_ {};            // Запись с самым длинным литералом формата.
+    match_mode mode_ = match_mode::structure;
+    bool fixed_      = false;
+    bool multiline_  = false;
+};
+
+// Проверка строки на соответствие формату без конверсии полей и без построения результата.
+inline std::expected<bool, details::scan_error> matches(std::string_view input, std::string_view format,
+                                                        match_mode mode = match_mode::structure) {
+    auto matcher = scan_matcher::compile(format, mode);
+    if(!matcher) {
+        return std::unexpected(std::move(matcher.error()));
+    }
+    return matcher->matches(input);
+}
+
+inline bool matches(std::string_view input, const scan_matcher& matcher) {
+    return matcher.matches(input);
+}
+
+// Число строк буфера, совпавших с форматом.
+inline std::size_t count_matches(std::string_view buffer, const scan_matcher& matcher) {
+    std::size_t count = 0;
+    matcher.for_each_match(buffer, [&](std::size_t, std::string_view) { ++count; });
+    return count;
+}
+
+inline std::expected<std::size_t, details::scan_error> count_matches(std::string_view buffer, std::string_view format,
+                                                                     match_mode mode = match_mode::structure) {
+    auto matcher = scan_matcher::compile(format, mode);
+    if(!matcher) {
+        return std::unexpected(std::move(matcher.error()));
+    }
+    return count_matches(buffer, matcher.value());
+}
+
+// Смещения начал строк буфера, совпавших с форматом, в порядке следования.
+inline std::vector<std::size_t> filter_matches(std::string_view buffer, const scan_matcher& matcher) {
+    std::vector<std::size_t> offsets;
+    matcher.for_each_match(buffer, [&](std::size_t offset, std::string_view) { offsets.push_back(offset); });
+    return offsets;
+}
+
+inline std::expected<std::vector<std::size_t>, details::scan_error>
+filter_matches(std::string_view buffer, std::string_view format, match_mode mode = match_mode::structure) {
+    auto matcher = scan_matcher::compile(format, mode);
+    if(!matcher) {
+        return std::unexpected(std::move(matcher.error()));
+    }
+    return filter_matches(buffer, matcher.value());
+}
+
+}  // namespace stdx
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <expected>
+#include <iterator>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "lines.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Настройки параллельного сканирования.
+struct parallel_options {
+    std::size_t threads    = 0;        // Число потоков; 0 означает std::thread::hardware_concurrency().
+    std::size_t chunk_size = 1 << 20;  // Примерный размер куска входа в байтах; куски режутся по границам строк.
+};
+
+namespace details {
+
+// Очередь задач одного исполнителя: владелец берёт задачи с конца, остальные перехватывают их с начала.
+class work_stealing_queue {
+public:
+    void push(std::size_t task) {
+        std::lock_guard lock {mutex_};
+        tasks_.push_back(task);
+    }
+
+    bool try_pop(std::size_t& task) {
+        std::lock_guard lock {mutex_};
+        if(tasks_.empty()) {
+            return false;
+        }
+        task = tasks_.back();
+        tasks_.pop_back();
+        return true;
+    }
+
+    bool try_steal(std::size_t& task) {
+        std::lock_guard lock {mutex_};
+        if(tasks_.empty()) {
+            return false;
+        }
+        task = tasks_.front();
+        tasks_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<std::size_t> tasks_;
+};
+
+// Выполнение tasks_count независимых задач на threads потоках с перехватом работы. Каждый исполнитель получает
+// непрерывный диапазон задач, а освободившись, забирает задачи у соседей. Вызывающий поток участвует как исполнитель 0.
+// task вызывается как task(номер задачи, номер исполнителя).
+//
+// Исключение из task не покидает поток пула: первое из них останавливает остальных исполнителей (задачи, уже начатые
+// ими, доделываются), а после завершения всех потоков пробрасывается вызывающему.
+template<typename F> void run_work_stealing(std::size_t tasks_count, std::size_t threads, F&& task) {
+    threads = std::max<std::size_t>(1, std::min(threads, tasks_count));
+    std::vector<work_stealing_queue> queues(threads);
+    for(std::size_t i = 0; i < tasks_count; ++i) {
+        // Задачи кладутся в обратном порядке, чтобы владелец, забирая с конца, шёл по своему диапазону вперёд.
+        std::size_t reversed = tasks_count - 1 - i;
+        queues[reversed * threads / tasks_count].push(reversed);
+    }
+
+    std::atomic<bool> failed {false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&](std::size_t self) {
+        try {
+            std::size_t current = 0;
+            while(!failed.load(std::memory_order_relaxed)) {
+                bool found = queues[self].try_pop(current);
+                for(std::size_t offset = 1; !found && offset < threads; ++offset) {
+                    found = queues[(self + offset) % threads].try_steal(current);
+                }
+                // Новые задачи не появляются, поэтому пустые очереди у всех означают завершение работы.
+                if(!found) {
+                    return;
+                }
+                task(current, self);
+            }
+        }
+        catch(...) {
+            std::lock_guard lock {error_mutex};
+            if(!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(threads - 1);
+        try {
+            for(std::size_t i = 1; i < threads; ++i) {
+                pool.emplace_back(worker, i);
+            }
+        }
+        catch(...) {
+            // Поток не создался: уже запущенные исполнители останавливаются и присоединяются при выходе из блока.
+            failed = true;
+            throw;
+        }
+        worker(0);
+    }
+    if(error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Разбиение буфера на куски размером около chunk_size байт, каждый из которых заканчивается сразу после '\n'
+// (кроме, возможно, последнего).
+inline std::vector<std::string_view> split_chunks(std::string_view buffer, std::size_t chunk_size) {
+    chunk_size = std::max<std::size_t>(1, chunk_size);
+    std::vector<std::string_view> chunks;
+    chunks.reserve(buffer.size() / chunk_size + 1);
+    std::size_t position = 0;
+    while(position < buffer.size()) {
+        std::size_t end = std::min(position + chunk_size, buffer.size());
+        if(end < buffer.size()) {
+            auto newline = buffer.find('\n', end - 1);
+            end          = newline == std::string_view::npos ? buffer.size() : newline + 1;
+        }
+        chunks.push_back(buffer.substr(position, end - position));
+        position = end;
+    }
+    return chunks;
+}
+
+// Число потоков для chunks кусков: 0 означает std::thread::hardware_concurrency(), и потоков не больше, чем кусков.
+inline std::size_t resolve_threads(std::size_t threads, std::size_t chunks) noexcept {
+    threads = threads != 0 ? threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(threads, chunks));
+}
+
+}  // namespace details
+
+// Параллельное построчное сканирование буфера по скомпилированному шаблону. Буфер режется на куски по границам строк,
+// куски сканируются на пуле потоков с перехватом работы, каждый в свой вектор. Число строк куска заранее не
+// известно, поэтому общий вектор размечается по длинам этих векторов уже после сканирования, и результаты
+// переносятся в него в исходном порядке строк.
+template<typename... Ts>
+std::vector<std::expected<details::scan_result<Ts...>, details::scan_error>>
+scan_parallel(std::string_view buffer, const scan_pattern<Ts...>& pattern, parallel_options options = {}) {
+    using line_result = std::expected<details::scan_result<Ts...>, details::scan_error>;
+
+    const auto chunks         = details::split_chunks(buffer, options.chunk_size);
+    const std::size_t threads = details::resolve_threads(options.threads, chunks.size());
+
+    std::vector<std::vector<line_result>> chunk_results(chunks.size());
+    details::run_work_stealing(chunks.size(), threads, [&](std::size_t chunk, std::size_t) {
+        const std::string_view text = chunks[chunk];
+        std::size_t position        = 0;
+        while(position < text.size()) {
+            chunk_results[chunk].push_back(pattern.scan(details::next_line(text, position)));
+        }
+    });
+
+    std::size_t lines = 0;
+    for(const auto& part : chunk_results) {
+        lines += part.size();
+    }
+    std::vector<line_result> results;
+    results.reserve(lines);
+    for(auto& part : chunk_results) {
+        std::ranges::move(part, std::back_inserter(results));
+        part = {};
+    }
+    return results;
+}
+
+// Параллельное сканирование с передачей результатов в on_result(смещение начала строки в buffer, результат) вместо
+// накопления в векторе. Строки одного куска передаются одним потоком в исходном порядке, но разные куски
+// обрабатываются одновременно, поэтому on_result должен быть потокобезопасным. Исключение из on_result
+// останавливает сканирование и пробрасывается вызывающему.
+template<typename... Ts, typename F>
+    requires std::invocable<F&, std::size_t, std::expected<details::scan_result<Ts...>, details::scan_error>&&>
+void scan_parallel(std::string_view buffer, const scan_pattern<Ts...>& pattern, F&& on_result,
+                   parallel_options options = {}) {
+    const auto chunks         = details::split_chunks(buffer, options.chunk_size);
+    const std::size_t threads = details::resolve_threads(options.threads, chunks.size());
+
+    details::run_work_stealing(chunks.size(), threads, [&](std::size_t chunk, std::size_t) {
+        const std::string_view text = chunks[chunk];
+        const auto base             = static_cast<std::size_t>(text.data() - buffer.data());
+        std::size_t position        = 0;
+        while(position < text.size()) {
+            const std::size_t offset = base + position;
+            on_result(offset, pattern.scan(details::next_line(text, position)));
+        }
+    });
+}
+
+// Параллельное построчное сканирование буфера по форматной строке: формат компилируется один раз.
+template<typename... Ts>
+std::expected<std::vector<std::expected<details::scan_result<Ts...>, details::scan_error>>, details::scan_error>
+scan_parallel(std::string_view buffer, std::string_view format, parallel_options options = {}) {
+    auto pattern = scan_pattern<Ts...>::compile(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return scan_parallel(buffer, pattern.value(), options);
+}
+
+// Параллельное сканирование по форматной строке с передачей результатов в on_result.
+template<typename... Ts, typename F>
+    requires std::invocable<F&, std::size_t, std::expected<details::scan_result<Ts...>, details::scan_error>&&>
+std::expected<void, details::scan_error> scan_parallel(std::string_view buffer, std::string_view format,
+                                                       F&& on_result, parallel_options options = {}) {
+    auto pattern = scan_pattern<Ts...>::compile(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    scan_parallel(buffer, pattern.value(), on_result, options);
+    return {};
+}
+
+}  // namespace stdx
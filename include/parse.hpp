@@ -1,22 +1,33 @@
 #pragma once
 
+#include <array>
 #include <expected>
 #include <string>
 #include <string_view>
 #include <utility>
-#include <vector>
 #include <cmath>
 #include <limits>
 
+#include "config.hpp"
+#include "decimal.hpp"
+#include "integer.hpp"
+#include "search.hpp"
+#include "simd.hpp"
 #include "types.hpp"
 
-namespace stdx::details {
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
 
 using namespace std::literals;
 
-// Функция-хелпер для конверсии строки в число.
+// Функция-хелпер для конверсии строки в число. Целые числа разбираются SWAR-ядром parse_integer с тем же контрактом,
+// что и у std::from_chars.
 template<typename T> constexpr auto from_chars(const char* first, const char* last, T& value) {
-    return std::from_chars(first, last, value);
+    if constexpr(std::is_integral_v<T>) {
+        return parse_integer(first, last, value);
+    }
+    else {
+        return std::from_chars(first, last, value);
+    }
 }
 
 // Перегрузка для double.
@@ -37,44 +48,62 @@ concept is_parsable = std::same_as<T, signed char> ||
                       std::same_as<T, float> ||
                       std::same_as<T, double>;
 
-template<is_parsable T> constexpr std::expected<T, std::format_error> parse_value(std::string_view view) {
+// Имя типа для текста ошибки конверсии.
+template<typename T> constexpr const char* type_name() {
+    if constexpr(std::same_as<T, signed char>) {
+        return "signed char";
+    }
+    else if constexpr(std::same_as<T, unsigned char>) {
+        return "unsigned char";
+    }
+    else if constexpr(std::same_as<T, signed short int>) {
+        return "signed short int";
+    }
+    else if constexpr(std::same_as<T, unsigned short int>) {
+        return "unsigned short int";
+    }
+    else if constexpr(std::same_as<T, int>) {
+        return "int";
+    }
+    else if constexpr(std::same_as<T, unsigned int>) {
+        return "unsigned int";
+    }
+    else if constexpr(std::same_as<T, long long int>) {
+        return "long long int";
+    }
+    else if constexpr(std::same_as<T, unsigned long long int>) {
+        return "unsigned long long int";
+    }
+    else if constexpr(std::same_as<T, float>) {
+        return "float";
+    }
+    else if constexpr(std::same_as<T, double>) {
+        return "double";
+    }
+    else if constexpr(is_decimal<T>) {
+        return "decimal";
+    }
+    else {
+        return "unexpected type";
+    }
+}
+
+// Разбор числа без построения текста ошибки: неуспех возвращается кодом std::errc.
+template<is_parsable T> constexpr std::expected<T, std::errc> parse_value(std::string_view view) {
     T result {};
     auto [ptr, ec] = from_chars<T>(view.data(), view.data() + view.size(), result);
+    if(ec != std::errc()) {
+        return std::unexpected(ec);
+    }
+    return result;
+}
 
+// Разбор десятичного числа с фиксированной точкой без промежуточного double.
+template<is_decimal T> constexpr std::expected<T, std::errc> parse_decimal_value(std::string_view view) {
+    T result {};
+    auto [ptr, ec] = parse_decimal(view.data(), view.data() + view.size(), result);
     if(ec != std::errc()) {
-        if constexpr(std::same_as<T, signed char>) {
-            return std::unexpected(std::format_error("Failed to convert to <signed char>."));
-        }
-        else if constexpr(std::same_as<T, unsigned char>) {
-            return std::unexpected(std::format_error("Failed to convert to <unsigned char>."));
-        }
-        if constexpr(std::same_as<T, signed short int>) {
-            return std::unexpected(std::format_error("Failed to convert to <signed short int>."));
-        }
-        else if constexpr(std::same_as<T, unsigned short int>) {
-            return std::unexpected(std::format_error("Failed to convert to <unsigned short int>."));
-        }
-        else if constexpr(std::same_as<T, int>) {
-            return std::unexpected(std::format_error("Failed to convert to <int>."));
-        }
-        else if constexpr(std::same_as<T, unsigned int>) {
-            return std::unexpected(std::format_error("Failed to convert to <unsigned int>."));
-        }
-        else if constexpr(std::same_as<T, long long int>) {
-            return std::unexpected(std::format_error("Failed to convert to <long long int>."));
-        }
-        else if constexpr(std::same_as<T, unsigned long long int>) {
-            return std::unexpected(std::format_error("Failed to convert to <unsigned long long int>."));
-        }
-        else if constexpr(std::same_as<T, float>) {
-            return std::unexpected(std::format_error("Failed to convert to <float>."));
-        }
-        else if constexpr(std::same_as<T, double>) {
-            return std::unexpected(std::format_error("Failed to convert to <double>."));
-        }
-        else {
-            return std::unexpected(std::format_error("Unxpected type T failed to get converted."));
-        }
+        return std::unexpected(ec);
     }
     return result;
 }
@@ -87,8 +116,7 @@ template<typename T> constexpr std::expected<T, scan_error> process_empty_placeh
     else if constexpr(is_integral<T>) {
         auto int_res = parse_value<long long int>(input);
         if(!int_res) {
-            return std::unexpected(
-                scan_error("Unexpected result. Failed to parse integer for {}: "s + int_res.error().what()));
+            return std::unexpected(scan_error(scan_errc::invalid_integer_placeholder, type_name<long long int>()));
         }
         auto parsed_int = int_res.value();
 
@@ -98,32 +126,45 @@ template<typename T> constexpr std::expected<T, scan_error> process_empty_placeh
                 // Значение должно укладываться в допустимый диапазон типа.
                 if(parsed_int < static_cast<long long int>(std::numeric_limits<T>::min()) ||
                    parsed_int > static_cast<long long int>(std::numeric_limits<T>::max())) {
-                    return std::unexpected(scan_error("Unexpected result. Integer out of range for target type {}."s));
+                    return std::unexpected(scan_error(scan_errc::integer_out_of_range));
                 }
             }
         }
         else {  // Проверка беззнакового int.
             // Беззнаковый тип не может быть отрицатлеьным.
             if(parsed_int < 0) {
-                return std::unexpected(scan_error("Unexpected result. Negative value parsed for unsigned type {}."s));
+                return std::unexpected(scan_error(scan_errc::negative_unsigned));
             }
             if constexpr(sizeof(T) < sizeof(unsigned long long int)) {  // Для uint8_t, uint16_t, uint32_t, uint64_t.
                 // Значение должно укладываться в допустимый диапазон типа.
                 if(static_cast<unsigned long long int>(parsed_int) >
                    static_cast<unsigned long long int>(std::numeric_limits<T>::max())) {
-                    return std::unexpected(
-                        scan_error("Unexpected result. Unsigned integer out of range for target type {}."s));
+                    return std::unexpected(scan_error(scan_errc::unsigned_out_of_range));
                 }
             }
         }
         // В этой точке тип T не будет "обрезан".
         return static_cast<T>(parsed_int);
     }
+    else if constexpr(is_decimal<T>) {
+        auto decimal_res = parse_decimal_value<std::remove_cv_t<T>>(input);
+        if(!decimal_res) {
+            return std::unexpected(
+                scan_error(scan_errc::invalid_decimal_placeholder, type_name<std::remove_cv_t<T>>()));
+        }
+        return decimal_res.value();
+    }
     else if constexpr(is_floating<T>) {
+        if constexpr(std::is_same_v<std::remove_cv_t<T>, float>) {
+            // Быстрый путь: разбор сразу во float. Некорректный вход и значения, непредставимые во float, повторно
+            // разбираются в double ниже, чтобы сохранить прежние ошибки и поведение на границах диапазона.
+            if(auto direct = parse_value<float>(input)) {
+                return direct.value();
+            }
+        }
         auto floating_res = parse_value<double>(input);
         if(!floating_res) {
-            return std::unexpected(
-                scan_error("Unexpected result. Failed to parse float for {}: "s + floating_res.error().what()));
+            return std::unexpected(scan_error(scan_errc::invalid_floating_placeholder, type_name<double>()));
         }
         double parsed_double = floating_res.value();
 
@@ -131,100 +172,333 @@ template<typename T> constexpr std::expected<T, scan_error> process_empty_placeh
         if constexpr(std::is_same_v<std::remove_cv_t<T>, float>) {
             constexpr auto float_lowest = std::numeric_limits<T>::lowest();
             constexpr auto float_max    = std::numeric_limits<T>::max();
-            if(parsed_double < static_cast<double>(std::numeric_limits<T>::lowest()) ||
-               parsed_double > static_cast<double>(std::numeric_limits<T>::max())) {
-                return std::unexpected(
-                    scan_error("Unexpected result. Double value out of range for float target type {}."s));
+            if(parsed_double < static_cast<double>(float_lowest) || parsed_double > static_cast<double>(float_max)) {
+                return std::unexpected(scan_error(scan_errc::floating_out_of_range));
             }
         }
         // В этой точке тип T не будет "обрезан".
         return static_cast<T>(parsed_double);
     }
     else {
-        return std::unexpected(scan_error("Unexpected result. Type not supported for {} placeholder."s));
+        return std::unexpected(scan_error(scan_errc::unsupported_type));
     }
 }
 
-// Функция для парсинга значения с учетом спецификатора формата.
-template<typename T>
-constexpr std::expected<T, scan_error> parse_value_with_format(std::string_view input, std::string_view fmt) {
+// Наибольшее число цифр ширины поля в спецификаторе: больше не нужно записям фиксированной длины и не переполняет
+// std::size_t.
+inline constexpr std::size_t max_width_digits = 6;
+
+// Ширина поля из спецификатора вида %<ширина><символ>, например 8 для %8d. Для спецификатора без ширины, с нулевой
+// шириной или с посторонними символами возвращается 0.
+constexpr std::size_t spec_width(std::string_view fmt) noexcept {
+    if(fmt.length() < 3 || fmt[0] != '%' || fmt.length() - 2 > max_width_digits) {
+        return 0;
+    }
+    std::size_t width = 0;
+    for(char digit : fmt.substr(1, fmt.length() - 2)) {
+        if(digit < '0' || digit > '9') {
+            return 0;
+        }
+        width = width * 10 + static_cast<std::size_t>(digit - '0');
+    }
+    return width;
+}
+
+// Значение поля фиксированной ширины без выравнивающих пробелов: строки выравниваются по левому краю, поэтому у них
+// отбрасываются только пробелы справа, а у чисел - с обеих сторон.
+constexpr std::string_view trim_padding(std::string_view value, spec_kind kind) noexcept {
+    const char* first = value.data();
+    const char* last  = first + value.size();
+    if(kind != spec_kind::string) {
+        while(first != last && *first == ' ') {
+            ++first;
+        }
+    }
+    while(last != first && last[-1] == ' ') {
+        --last;
+    }
+    return {first, static_cast<std::size_t>(last - first)};
+}
+
+// Функция для разбора содержимого плейсхолдера {} в вид спецификатора формата.
+constexpr std::expected<spec_kind, format_issue> parse_spec(std::string_view fmt) {
     // Если на внутри плейсхолдера пустая строка, то обработка данных в input на месте плейсхолдера как строки.
     if(fmt.empty()) {
+        return spec_kind::empty;
+    }
+    // {*} сопоставляет поле, но не конвертирует его.
+    else if(fmt == "*") {
+        return spec_kind::skip;
+    }
+    // Невалидный префикс спецификатор формата, либо спецификатор формата больше одного символа. Между % и символом
+    // спецификатора допускается ширина поля фиксированной длины, например {%8d}.
+    else if(fmt[0] == '%' && fmt.length() >= 2) {
+        if(fmt.length() > 2 && spec_width(fmt) == 0) {
+            return std::unexpected(format_issue::wrong_specifier);
+        }
+        switch(static_cast<unsigned char>(fmt.back())) {
+            case 's':
+                return spec_kind::string;
+            case 'd':
+                return spec_kind::integral;
+            case 'u':
+                return spec_kind::natural;
+            case 'f':
+                return spec_kind::floating;
+            default:
+                return std::unexpected(format_issue::unexpected_specifier);
+        }
+    }
+    else {
+        return std::unexpected(format_issue::wrong_specifier);
+    }
+}
+
+// Ошибка для причины, по которой форматная строка не может быть скомпилирована.
+constexpr scan_error format_issue_error(format_issue issue) {
+    switch(issue) {
+        case format_issue::unexpected_specifier:
+            return scan_error(scan_errc::unexpected_specifier);
+        case format_issue::wrong_specifier:
+            return scan_error(scan_errc::wrong_specifier);
+        case format_issue::mismatched_count:
+            return scan_error(scan_errc::mismatched_count);
+        case format_issue::adjacent_placeholders:
+            return scan_error(scan_errc::index_out_of_bounds);
+    }
+    return scan_error(scan_errc::unexpected_specifier);
+}
+
+// Проверка в compile-time соответствия типа T виду спецификатора формата.
+template<typename T> constexpr bool is_spec_compatible(spec_kind kind) {
+    switch(kind) {
+        case spec_kind::empty:
+            return std::is_constructible_v<T, std::string_view> || is_integral<T> || is_floating<T> || is_decimal<T>;
+        case spec_kind::string:
+            return is_c_string<T> || is_string<T> || is_pmr_string<T> || is_string_view<T>;
+        case spec_kind::integral:
+            return is_integral<T>;
+        case spec_kind::natural:
+            return is_natural<T>;
+        case spec_kind::floating:
+            return is_floating<T> || is_decimal<T>;
+        case spec_kind::skip:
+            // Пропущенное поле остаётся значением по умолчанию, поэтому подходит любой такой тип.
+            return std::is_default_constructible_v<T>;
+    }
+    return false;
+}
+
+// Ошибка несоответствия типа T виду спецификатора формата.
+template<typename T> constexpr scan_error spec_mismatch_error(spec_kind kind) {
+    switch(kind) {
+        case spec_kind::empty:
+            return scan_error(scan_errc::unsupported_type);
+        case spec_kind::string:
+            return scan_error(scan_errc::string_type_mismatch);
+        case spec_kind::integral:
+            return scan_error(scan_errc::integral_type_mismatch);
+        case spec_kind::natural:
+            return scan_error(scan_errc::natural_type_mismatch);
+        case spec_kind::floating:
+            return scan_error(scan_errc::floating_type_mismatch);
+        case spec_kind::skip:
+            return scan_error(scan_errc::unsupported_type);
+    }
+    return scan_error(scan_errc::unexpected_specifier);
+}
+
+// Функция для конверсии данных из input в тип T для заранее известного вида спецификатора формата Kind.
+template<typename T, spec_kind Kind> constexpr std::expected<T, scan_error> convert_as(std::string_view input) {
+    if constexpr(Kind == spec_kind::empty) {
         // Обработка данных в input на месте пустого {} placeholder.
         return process_empty_placeholder<T>(input);
     }
-    // Невалидный префикс спецификатор формата, либо спецификатор формата больше одного символа.
-    else if(fmt[0] == '%' && fmt.length() == 2) {
-        // Обработка спецификаторов формата.
-        switch(static_cast<unsigned char>(fmt[1])) {
-            case 's': {
-                if constexpr(is_c_string<T>) {
-                    return reinterpret_cast<const char*>(input.data());
-                }
-                if constexpr(is_string<T> || is_string_view<T>) {
-                    return std::string{input};
-                }
-                else {
-                    return std::unexpected(
-                        scan_error("Unexpected result. Type mismatch: 's' specifier requires a string-line type."s));
-                }
-            }
-            case 'd': {
-                if constexpr(is_integral<T>) {
-                    auto res = parse_value<T>(input);
-                    if(!res) {
-                        return std::unexpected(scan_error("Unexpected result."s + res.error().what()));
-                    }
-                    return res.value();
-                }
-                else {
-                    return std::unexpected(
-                        scan_error("Unexpected result. Type mismatch: 'd' specifier requires an integral type."s));
-                }
-            }
-            case 'u': {
-                if constexpr(is_natural<T>) {
-                    auto res = parse_value<T>(input);
-                    if(!res) {
-                        return std::unexpected(
-                            scan_error("Unexpected result."s + res.error().what()));
-                    }
-                    return res.value();
-                }
-                else {
-                    return std::unexpected(scan_error(
-                        "Unexpected result. Type mismatch: 'u' specifier requires a natural (unsigned integer) type."s));
-                }
-            }
-            case 'f': {
-                if constexpr(is_floating<T>) {
-                    auto res = parse_value<double>(input);
-                    ;
-                    if(!res) {
-                        return std::unexpected(scan_error("Unexpected result. "s + res.error().what()));
-                    }
-                    return res.value();
-                }
-                else {
-                    return std::unexpected(
-                        scan_error("Unexpected result. Type mismatch: 'f' specifier requires a floating type."s));
-                }
+    else if constexpr(Kind == spec_kind::skip && std::is_default_constructible_v<T>) {
+        return T {};
+    }
+    else if constexpr(Kind == spec_kind::string && is_c_string<T>) {
+        return reinterpret_cast<const char*>(input.data());
+    }
+    else if constexpr(Kind == spec_kind::string && is_string_view<T>) {
+        // Без копирования: представление указывает прямо во входную строку.
+        return input;
+    }
+    else if constexpr(Kind == spec_kind::string && is_string<T>) {
+        return std::string {input};
+    }
+    else if constexpr(Kind == spec_kind::string && is_pmr_string<T>) {
+        return T {input};
+    }
+    else if constexpr((Kind == spec_kind::integral && is_integral<T>) ||
+                      (Kind == spec_kind::natural && is_natural<T>)) {
+        auto res = parse_value<T>(input);
+        if(!res) {
+            return std::unexpected(scan_error(scan_errc::invalid_integer, type_name<T>()));
+        }
+        return res.value();
+    }
+    else if constexpr(Kind == spec_kind::floating && is_decimal<T>) {
+        auto res = parse_decimal_value<std::remove_cv_t<T>>(input);
+        if(!res) {
+            return std::unexpected(scan_error(scan_errc::invalid_floating, type_name<std::remove_cv_t<T>>()));
+        }
+        return res.value();
+    }
+    else if constexpr(Kind == spec_kind::floating && is_floating<T>) {
+        if constexpr(std::is_same_v<std::remove_cv_t<T>, float>) {
+            // Быстрый путь без промежуточного double; при ошибке разбор повторяется в double ради прежних сообщений.
+            if(auto direct = parse_value<float>(input)) {
+                return direct.value();
             }
-            default:
-                return std::unexpected(scan_error("Unexpected result. Unexpected format specifier."s));
         }
+        auto res = parse_value<double>(input);
+        if(!res) {
+            return std::unexpected(scan_error(scan_errc::invalid_floating, type_name<double>()));
+        }
+        return res.value();
     }
     else {
-        return std::unexpected(scan_error("Unexpected result. Wrong or too long format specifier."s));
+        return std::unexpected(spec_mismatch_error<T>(Kind));
+    }
+}
+
+// Функция для конверсии данных из input в тип T согласно уже разобранному спецификатору формата.
+template<typename T> constexpr std::expected<T, scan_error> convert_value(std::string_view input, spec_kind kind) {
+    switch(kind) {
+        case spec_kind::empty:
+            return convert_as<T, spec_kind::empty>(input);
+        case spec_kind::string:
+            return convert_as<T, spec_kind::string>(input);
+        case spec_kind::integral:
+            return convert_as<T, spec_kind::integral>(input);
+        case spec_kind::natural:
+            return convert_as<T, spec_kind::natural>(input);
+        case spec_kind::floating:
+            return convert_as<T, spec_kind::floating>(input);
+        case spec_kind::skip:
+            return convert_as<T, spec_kind::skip>(input);
     }
+    return std::unexpected(spec_mismatch_error<T>(kind));
+}
+
+// Конверсия данных из input прямо в поле результата field. Строки заполняются на месте: std::pmr::string берёт
+// память из ресурса, с которым создан результат, а строка с достаточной ёмкостью переиспользует свой буфер.
+template<typename T>
+constexpr std::expected<void, scan_error> convert_into(std::string_view input, spec_kind kind, T& field) {
+    if(kind == spec_kind::skip) {
+        return {};
+    }
+    if constexpr(is_pmr_string<T> || is_string<T>) {
+        if(kind == spec_kind::empty || kind == spec_kind::string) {
+            field.assign(input);
+            return {};
+        }
+    }
+    auto converted = convert_value<T>(input, kind);
+    if(!converted) {
+        return std::unexpected(std::move(converted.error()));
+    }
+    field = std::move(converted.value());
+    return {};
+}
+
+// Привязка ошибки конверсии к полю: индекс поля и смещение его значения во входной строке input.
+constexpr scan_error& locate_field(scan_error& error, std::size_t field, std::string_view input,
+                                   std::string_view value) noexcept {
+    error.field  = field;
+    error.offset = static_cast<std::size_t>(value.data() - input.data());
+    return error;
+}
+
+// Функция для парсинга значения с учетом спецификатора формата.
+template<typename T>
+constexpr std::expected<T, scan_error> parse_value_with_format(std::string_view input, std::string_view fmt) {
+    auto kind = parse_spec(fmt);
+    if(!kind) {
+        return std::unexpected(format_issue_error(kind.error()));
+    }
+    return convert_value<T>(input, kind.value());
+}
+
+// Хранилище частей строки фиксированного размера N, не выделяющее память. Части сверх N не сохраняются, а только
+// подсчитываются, чтобы вызывающий код мог обнаружить несовпадение числа спецификаторов и типов.
+template<std::size_t N> struct fixed_parts {
+    std::array<std::string_view, N> items {};
+    std::size_t count = 0;
+
+    constexpr void push_back(std::string_view part) noexcept {
+        if(count < N) {
+            items[count] = part;
+        }
+        ++count;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return count;
+    }
+
+    constexpr std::string_view operator[](std::size_t i) const noexcept {
+        return items[i];
+    }
+};
+
+// Заданы ли ширины у всех плейсхолдеров формата (и есть ли хотя бы один). Такая запись позиционная: как и
+// в compile_layout, её первый литерал обязан стоять в начале входной строки.
+constexpr bool all_fields_sized(std::string_view format) noexcept {
+    bool sized        = false;
+    std::size_t start = 0;
+    while(true) {
+        std::size_t open = format.find('{', start);
+        if(open == std::string_view::npos) {
+            break;
+        }
+        std::size_t close = format.find('}', open);
+        if(close == std::string_view::npos) {
+            break;
+        }
+        if(spec_width(format.substr(open + 1, close - open - 1)) == 0) {
+            return false;
+        }
+        sized = true;
+        start = close + 1;
+    }
+    return sized;
 }
 
 // Функция для проверки корректности входных данных и выделения из обеих строк интересующих данных для парсинга.
-template<typename... Ts>
-constexpr std::expected<std::pair<std::vector<std::string_view>, std::vector<std::string_view>>, scan_error>
-parse_sources(std::string_view input, std::string_view format) {
-    std::vector<std::string_view> format_parts;  // Части формата между {}
-    std::vector<std::string_view> input_parts;
+// Шаблон зависит только от числа полей N, а не от их типов.
+template<std::size_t N>
+constexpr std::expected<std::pair<fixed_parts<N>, fixed_parts<N>>, scan_error> parse_sources(std::string_view input,
+                                                                                            std::string_view format) {
+    fixed_parts<N> format_parts;  // Части формата между {}
+    fixed_parts<N> input_parts;
+    const char* origin = input.data();
+    auto mismatch      = [&] {
+        scan_error error(scan_errc::literal_mismatch);
+        error.field  = format_parts.size();
+        error.offset = static_cast<std::size_t>(input.data() - origin);
+        return std::unexpected(error);
+    };
+    // Поле фиксированной ширины (например {%8d}) вырезается ровно по ширине, а следующий за ним литерал сравнивается
+    // на месте, без поиска.
+    std::size_t width = 0;
+    spec_kind kind    = spec_kind::empty;
+    auto take_sized   = [&](std::string_view next) -> std::expected<void, scan_error> {
+        if(input.size() < width) {
+            scan_error error(scan_errc::field_too_short);
+            error.field  = format_parts.size() - 1;
+            error.offset = static_cast<std::size_t>(input.data() - origin);
+            return std::unexpected(error);
+        }
+        input_parts.push_back(trim_padding(input.substr(0, width), kind));
+        input = input.substr(width);
+        if(!input.starts_with(next)) {
+            return mismatch();
+        }
+        input = input.substr(next.size());
+        return {};
+    };
     size_t start = 0;
     while(true) {
         size_t open = format.find('{', start);
@@ -236,41 +510,319 @@ parse_sources(std::string_view input, std::string_view format) {
             break;
         }
 
+        if(width != 0) {
+            if(auto taken = take_sized(format.substr(start, open - start)); !taken) {
+                return std::unexpected(std::move(taken.error()));
+            }
+        }
+        // Первый литерал позиционной записи сравнивается с началом input, как в walk_fields.
+        else if(start == 0 && open > 0 && all_fields_sized(format)) {
+            if(!input.starts_with(format.substr(0, open))) {
+                return mismatch();
+            }
+            input = input.substr(open);
+        }
         // Если между предыдущей } и текущей { есть текст,
         // проверяем его наличие во входной строке
-        if(open > start) {
+        else if(open > start) {
             std::string_view between = format.substr(start, open - start);
-            auto pos                 = input.find(between);
+            auto pos                 = find_literal_linear(input, between);
             if(input.size() < between.size() || pos == std::string_view::npos) {
-                return std::unexpected(
-                    scan_error {"Unexpected result. Unformatted text in input and format string are different"});
+                return mismatch();
             }
             if(start != 0) {
-                input_parts.emplace_back(input.substr(0, pos));
+                input_parts.push_back(input.substr(0, pos));
             }
 
             input = input.substr(pos + between.size());
         }
 
         // Сохраняем спецификатор формата (то, что между {})
-        format_parts.push_back(format.substr(open + 1, close - open - 1));
+        auto spec = format.substr(open + 1, close - open - 1);
+        format_parts.push_back(spec);
+        width = spec_width(spec);
+        if(width != 0) {
+            kind = parse_spec(spec).value_or(spec_kind::empty);
+        }
         start = close + 1;
     }
 
     // Проверяем оставшийся текст после последней }
-    if(start < format.size()) {
+    if(width != 0) {
+        if(auto taken = take_sized(format.substr(start)); !taken) {
+            return std::unexpected(std::move(taken.error()));
+        }
+    }
+    else if(start < format.size()) {
         std::string_view remaining_format = format.substr(start);
-        auto pos                          = input.find(remaining_format);
+        auto pos                          = find_literal_linear(input, remaining_format);
         if(input.size() < remaining_format.size() || pos == std::string_view::npos) {
-            return std::unexpected(
-                scan_error {"Unexpected result. Unformatted text in input and format string are different"});
+            return mismatch();
         }
-        input_parts.emplace_back(input.substr(0, pos));
+        input_parts.push_back(input.substr(0, pos));
         input = input.substr(pos + remaining_format.size());
     }
     else {
-        input_parts.emplace_back(input);
+        input_parts.push_back(input);
     }
     return std::pair {format_parts, input_parts};
 }
+
+// Литеральный сегмент форматной строки, хранимый смещением и длиной.
+struct segment {
+    std::size_t offset {};
+    std::size_t length {};
+};
+
+// Плейсхолдер формата вместе с литералом перед ним. Ширина 0 означает поле, ограниченное следующим литералом. Для
+// длинного литерала в plan заранее построена факторизация Two-Way, поэтому его поиск линеен по длине входной строки.
+// Литерал после последнего плейсхолдера хранится отдельной записью, у которой kind и width не используются.
+struct field_entry {
+    segment literal {};
+    literal_plan plan {};
+    spec_kind kind {};
+    std::size_t width = 0;
+};
+
+// Скомпилированное описание форматной строки с N плейсхолдерами: N полей и хвостовой литерал. Если ширина задана
+// у всех полей, запись позиционная (fixed).
+template<std::size_t N> struct format_layout {
+    std::array<field_entry, N + 1> entries {};
+    bool fixed = false;
+
+    // Виды спецификаторов полей по порядку.
+    constexpr std::array<spec_kind, N> kinds() const noexcept {
+        std::array<spec_kind, N> result {};
+        for(std::size_t i = 0; i < N; ++i) {
+            result[i] = entries[i].kind;
+        }
+        return result;
+    }
+};
+
+// Разбор форматной строки тем же способом, что и в parse_sources, в описание с ровно N плейсхолдерами.
+template<std::size_t N>
+constexpr std::expected<format_layout<N>, format_issue> compile_layout(std::string_view format) {
+    format_layout<N> layout;
+    std::size_t fields = 0;
+    std::size_t start  = 0;
+    while(true) {
+        std::size_t open = format.find('{', start);
+        if(open == std::string_view::npos) {
+            break;
+        }
+        std::size_t close = format.find('}', open);
+        if(close == std::string_view::npos) {
+            break;
+        }
+
+        if(fields >= N) {
+            return std::unexpected(format_issue::mismatched_count);
+        }
+        // Между соседними плейсхолдерами обязан быть разделитель, иначе границу поля найти невозможно. Исключение -
+        // поле фиксированной ширины: его граница известна без разделителя.
+        if(fields != 0 && open == start && layout.entries[fields - 1].width == 0) {
+            return std::unexpected(format_issue::adjacent_placeholders);
+        }
+
+        auto spec = format.substr(open + 1, close - open - 1);
+        auto kind = parse_spec(spec);
+        if(!kind) {
+            return std::unexpected(kind.error());
+        }
+        layout.entries[fields] = {{start, open - start},
+                                  plan_literal(format.substr(start, open - start)),
+                                  kind.value(),
+                                  spec_width(spec)};
+        ++fields;
+        start = close + 1;
+    }
+
+    if(fields != N) {
+        return std::unexpected(format_issue::mismatched_count);
+    }
+    // Оставшийся текст после последней } (либо незакрытый плейсхолдер) сопоставляется как литерал.
+    layout.entries[N].literal = {start, format.size() - start};
+    layout.entries[N].plan    = plan_literal(format.substr(start));
+
+    layout.fixed = N != 0;
+    for(std::size_t i = 0; i < N; ++i) {
+        layout.fixed = layout.fixed && layout.entries[i].width != 0;
+    }
+    return layout;
+}
+
+// Поиск литералов для walk_fields во всём остатке входной строки.
+struct input_finder {
+    constexpr std::size_t find(std::string_view input, std::string_view literal,
+                               const literal_plan& plan) const noexcept {
+        return find_literal_linear(input, literal, plan);
+    }
+
+    // Часть остатка input, которую забирает последнее поле без завершающего литерала.
+    constexpr std::string_view rest(std::string_view input) const noexcept {
+        return input;
+    }
+};
+
+// Обход границ полей записи, общий для всех сопоставлений по формату: entries - поля формата и хвостовой литерал
+// последней записью, литералы - сегменты строки format. Для каждого поля вызывается on_field(i, value). Семантика
+// поиска литералов совпадает с parse_sources: каждый литерал ищется с текущей позиции до первого вхождения, а каждый
+// следующий поиск начинается за концом предыдущего вхождения, поэтому сопоставление в целом линейно по длине input.
+// Поле фиксированной ширины занимает ровно width байт, а следующий за ним литерал сравнивается на месте. У позиционной
+// записи (fixed) и первый литерал обязан стоять в начале input; текст после последнего литерала игнорируется. Ошибка
+// несовпадения хранит индекс ненайденного литерала и смещение, с которого начинался его поиск.
+template<typename Entries, typename Finder, typename OnField>
+constexpr std::expected<void, scan_error> walk_fields(std::string_view input, std::string_view format,
+                                                      const Entries& entries, bool fixed, Finder&& finder,
+                                                      OnField&& on_field) {
+    const std::size_t count = std::size(entries) - 1;
+    auto literal            = [&](std::size_t i) {
+        return format.substr(entries[i].literal.offset, entries[i].literal.length);
+    };
+    const char* origin = input.data();
+    auto fail          = [&](scan_errc code, std::size_t field) {
+        scan_error error(code);
+        error.field  = field;
+        error.offset = static_cast<std::size_t>(input.data() - origin);
+        return std::unexpected(error);
+    };
+
+    auto prefix = literal(0);
+    if(count == 0) {
+        if(!prefix.empty() && finder.find(input, prefix, entries[0].plan) == std::string_view::npos) {
+            return fail(scan_errc::literal_mismatch, 0);
+        }
+        return {};
+    }
+    if(fixed) {
+        if(!input.starts_with(prefix)) {
+            return fail(scan_errc::literal_mismatch, 0);
+        }
+        input.remove_prefix(prefix.size());
+    }
+    else if(!prefix.empty()) {
+        auto pos = finder.find(input, prefix, entries[0].plan);
+        if(pos == std::string_view::npos) {
+            return fail(scan_errc::literal_mismatch, 0);
+        }
+        input.remove_prefix(pos + prefix.size());
+    }
+
+    for(std::size_t i = 0; i < count; ++i) {
+        const auto& current = entries[i];
+        auto next           = literal(i + 1);
+        if(current.width != 0) {
+            if(input.size() < current.width) {
+                return fail(scan_errc::field_too_short, i);
+            }
+            on_field(i, trim_padding(input.substr(0, current.width), current.kind));
+            input.remove_prefix(current.width);
+            if(!input.starts_with(next)) {
+                return fail(scan_errc::literal_mismatch, i + 1);
+            }
+            input.remove_prefix(next.size());
+        }
+        // Последнее поле без завершающего литерала забирает остаток строки.
+        else if(next.empty()) {
+            on_field(i, finder.rest(input));
+            break;
+        }
+        else {
+            auto pos = finder.find(input, next, entries[i + 1].plan);
+            if(pos == std::string_view::npos) {
+                return fail(scan_errc::literal_mismatch, i + 1);
+            }
+            on_field(i, input.substr(0, pos));
+            input.remove_prefix(pos + next.size());
+        }
+    }
+    return {};
+}
+
+// Выделение из input данных для каждого поля по скомпилированному описанию.
+template<std::size_t N>
+constexpr std::expected<void, scan_error> match_fields(std::string_view input, std::string_view format,
+                                                       const format_layout<N>& layout,
+                                                       std::array<std::string_view, N>& fields) {
+    return walk_fields(input, format, layout.entries, layout.fixed, input_finder {},
+                       [&](std::size_t i, std::string_view value) { fields[i] = value; });
+}
+
+// Поиск литералов для walk_fields в пределах одной строки буфера: buffer - весь остаток буфера, а строка
+// заканчивается первым '\n'. Поиск каждого литерала останавливается на конце строки, поэтому разделители и конец
+// строки находятся за один проход по байтам. Поля фиксированной ширины так не сопоставляются: их граница не
+// проверяется на '\n'.
+class line_finder {
+public:
+    explicit line_finder(std::string_view buffer) noexcept : buffer_(buffer) {}
+
+    // Длинный литерал ищется Two-Way в пределах строки, конец которой для этого находится отдельно.
+    std::size_t find(std::string_view input, std::string_view literal, const literal_plan& plan) {
+        const std::size_t cursor = offset(input);
+        if(literal.size() > short_literal_limit) {
+            const std::size_t limit = line_limit(cursor);
+            auto pos                = two_way_find(input.substr(0, limit - cursor), literal, plan);
+            if(pos == std::string_view::npos) {
+                line_end_ = limit;
+                return pos;
+            }
+            consumed_ = cursor + pos + literal.size();
+            return pos;
+        }
+        auto hit = find_literal_in_line(input, literal);
+        if(hit.newline || hit.position == std::string_view::npos) {
+            line_end_ = hit.position == std::string_view::npos ? buffer_.size() : cursor + hit.position;
+            return std::string_view::npos;
+        }
+        consumed_ = cursor + hit.position + literal.size();
+        return hit.position;
+    }
+
+    std::string_view rest(std::string_view input) {
+        const std::size_t cursor = offset(input);
+        return input.substr(0, line_limit(cursor) - cursor);
+    }
+
+    // Длина строки без '\n'. После неудачного поиска она уже известна, а после удачного сопоставления конец строки
+    // ищется за последним найденным литералом.
+    std::size_t line_end() {
+        if(line_end_ == std::string_view::npos) {
+            line_end_ = line_limit(consumed_);
+        }
+        return line_end_;
+    }
+
+private:
+    std::size_t offset(std::string_view input) const noexcept {
+        return static_cast<std::size_t>(input.data() - buffer_.data());
+    }
+
+    // Конец строки, найденный от cursor при первом обращении.
+    std::size_t line_limit(std::size_t cursor) {
+        if(limit_ == std::string_view::npos) {
+            auto newline = find_literal(buffer_.substr(cursor), "\n"sv);
+            limit_       = newline == std::string_view::npos ? buffer_.size() : cursor + newline;
+        }
+        return limit_;
+    }
+
+    std::string_view buffer_;
+    std::size_t limit_    = std::string_view::npos;
+    std::size_t line_end_ = std::string_view::npos;
+    std::size_t consumed_ = 0;  // Конец последнего найденного литерала.
+};
+
+// Однопроходный вариант match_fields для пакетного режима: input - весь остаток буфера, а строка заканчивается первым
+// '\n'. В line_end записывается длина строки без '\n' независимо от результата. Литералы формата не должны содержать
+// '\n', а поля - ширину.
+template<std::size_t N>
+bool match_line_fields(std::string_view input, std::string_view format, const format_layout<N>& layout,
+                       std::array<std::string_view, N>& fields, std::size_t& line_end) {
+    line_finder finder(input);
+    auto matched = walk_fields(input, format, layout.entries, false, finder,
+                               [&](std::size_t i, std::string_view value) { fields[i] = value; });
+    line_end     = finder.line_end();
+    return matched.has_value();
+}
 }  // namespace stdx::details
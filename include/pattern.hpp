@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "config.hpp"
+#include "lines.hpp"
+#include "parse.hpp"
+#include "stats.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+using namespace std::literals;
+
+// Предварительно скомпилированный шаблон сканирования. Форматная строка разбирается и проверяется на соответствие
+// типам Ts... один раз в compile(), а scan() только сопоставляет input с готовыми литеральными сегментами.
+template<typename... Ts> class scan_pattern {
+public:
+    static constexpr std::size_t fields_count = sizeof...(Ts);
+
+    // Разбор форматной строки тем же способом, что и в details::parse_sources, с проверкой спецификаторов и типов.
+    static std::expected<scan_pattern, details::scan_error> compile(std::string_view format) {
+        auto layout = details::compile_layout<fields_count>(format);
+        if(!layout) {
+            return std::unexpected(details::format_issue_error(layout.error()));
+        }
+
+        scan_pattern pattern;
+        pattern.format_ = format;
+        pattern.layout_ = layout.value();
+        // Литералы с '\n' не позволяют искать конец строки в одном проходе с разделителями, а поля фиксированной
+        // ширины вырезаются из уже выделенной строки.
+        pattern.multiline_ = format.find('\n') != std::string_view::npos ||
+                             std::ranges::any_of(pattern.layout_.entries, [](const details::field_entry& entry) {
+                                 return entry.width != 0;
+                             });
+        pattern.stats_     = details::register_format(format);
+
+        // Проверка соответствия типов спецификаторам один раз на этапе компиляции шаблона.
+        details::scan_error error;
+        auto check_fields = [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+            return (pattern.template check_field<Ids>(error) && ...);
+        };
+        if(!check_fields(std::index_sequence_for<Ts...> {})) {
+            return std::unexpected(std::move(error));
+        }
+        return pattern;
+    }
+
+    // Сканирование входной строки по скомпилированному шаблону.
+    std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input) const {
+        details::scan_result<Ts...> scanResult;
+        if(auto scanned = scan_to(input, scanResult); !scanned) {
+            return std::unexpected(std::move(scanned.error()));
+        }
+        return scanResult;
+    }
+
+    // Сканирование с ресурсом памяти для полей std::pmr::string.
+    std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input,
+                                                                         std::pmr::memory_resource* resource) const {
+        auto scanResult = details::make_scan_result<Ts...>(resource);
+        if(auto scanned = scan_to(input, scanResult); !scanned) {
+            return std::unexpected(std::move(scanned.error()));
+        }
+        return scanResult;
+    }
+
+    // Выделение из input данных для каждого поля без их конверсии.
+    std::expected<void, details::scan_error> match(std::string_view input,
+                                                   std::array<std::string_view, fields_count>& fields) const {
+        return details::match_fields(input, std::string_view {format_}, layout_, fields);
+    }
+
+    // Сопоставление очередной строки буфера, начинающейся с position, с переводом position за её '\n'. Для форматов
+    // без '\n' в литералах и полей фиксированной ширины разделители и конец строки ищутся за один проход.
+    bool match_line(std::string_view buffer, std::size_t& position,
+                    std::array<std::string_view, fields_count>& fields) const {
+        if(multiline_) {
+            return match(details::next_line(buffer, position), fields).has_value();
+        }
+        std::size_t line_end = 0;
+        bool matched = details::match_line_fields(buffer.substr(position), std::string_view {format_}, layout_, fields,
+                                                  line_end);
+        position += line_end + 1;
+        return matched;
+    }
+
+    std::string_view format() const noexcept {
+        return format_;
+    }
+
+    // Вид спецификатора поля с индексом i.
+    details::spec_kind kind(std::size_t i) const noexcept {
+        return layout_.entries[i].kind;
+    }
+
+    // Литерал с индексом i: 0 - текст перед первым плейсхолдером, fields_count - текст после последнего.
+    std::string_view literal(std::size_t i) const noexcept {
+        const auto [offset, length] = layout_.entries[i].literal;
+        return std::string_view {format_}.substr(offset, length);
+    }
+
+private:
+    scan_pattern() = default;
+
+    // Сканирование в заранее созданный результат scanResult.
+    std::expected<void, details::scan_error> scan_to(std::string_view input,
+                                                     details::scan_result<Ts...>& scanResult) const {
+        details::scan_probe probe(stats_, input.size());
+        std::array<std::string_view, fields_count> fields;
+        if(auto matched = match(input, fields); !matched) {
+            probe.failed(matched.error(), true);
+            return std::unexpected(std::move(matched.error()));
+        }
+        probe.matched();
+
+        details::scan_error error;
+        auto convert_fields = [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+            return (convert_field<Ids>(input, fields[Ids], scanResult, error) && ...);
+        };
+        if(!convert_fields(std::index_sequence_for<Ts...> {})) {
+            probe.failed(error, false);
+            return std::unexpected(std::move(error));
+        }
+        probe.succeeded();
+        return {};
+    }
+
+    template<std::size_t I> bool check_field(details::scan_error& error) const {
+        using TypeAtIndex = std::tuple_element_t<I, std::tuple<Ts...>>;
+        if(!details::is_spec_compatible<TypeAtIndex>(layout_.entries[I].kind)) {
+            error = details::spec_mismatch_error<TypeAtIndex>(layout_.entries[I].kind);
+            return false;
+        }
+        return true;
+    }
+
+    template<std::size_t I>
+    bool convert_field(std::string_view input, std::string_view field, details::scan_result<Ts...>& scanResult,
+                       details::scan_error& error) const {
+        auto parse_result = details::convert_into(field, layout_.entries[I].kind, std::get<I>(scanResult.result));
+        if(!parse_result) {
+            error = std::move(details::locate_field(parse_result.error(), I, input, field));
+            return false;
+        }
+        return true;
+    }
+
+    // Литеральные сегменты хранятся смещениями в format_, поэтому копирование шаблона их не инвалидирует.
+    std::string format_;
+    details::format_layout<fields_count> layout_ {};
+    bool multiline_ = false;
+    [[no_unique_address]] details::stats_key stats_ {};
+};
+
+}  // namespace stdx
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <expected>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_generator)
+#    include <generator>
+#endif
+
+#include "config.hpp"
+#include "pattern.hpp"
+#include "stream.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Настройки конвейерного сканирования scan_lines.
+struct pipeline_options {
+    std::size_t chunk_size  = 256 * 1024;  // Ёмкость куска чтения; запись длиннее куска пропускается с ошибкой.
+    std::size_t queue_depth = 4;           // Число прочитанных кусков, ожидающих сканирования.
+};
+
+namespace details {
+
+// Кусок потока из целых строк, выделенных стадией чтения. Строки идут подряд с позиции first, ends - позиции их
+// концов (без '\n'). Ошибка error относится к месту потока сразу после последней строки куска.
+struct line_chunk {
+    std::unique_ptr<char[]> data;
+    std::size_t first = 0;
+    std::vector<std::size_t> ends;
+    std::optional<scan_errc> error;
+
+    std::size_t lines() const noexcept {
+        return ends.size();
+    }
+
+    std::string_view line(std::size_t i) const noexcept {
+        const std::size_t begin = i == 0 ? first : ends[i - 1] + 1;
+        return {data.get() + begin, ends[i] - begin};
+    }
+};
+
+// Двухстадийный конвейер чтения: отдельный поток читает куски через read и режет их на строки, а потребитель
+// забирает готовые куски функцией next() и тем временем занимается конверсией. Стадии связаны ограниченной очередью:
+// кусков всего queue_depth + 2, и когда все они заняты, поток чтения ждёт, пока потребитель вернёт кусок. Поэтому
+// медленный потребитель останавливает чтение, а память не растёт сверх (queue_depth + 2) * chunk_size.
+//
+// Деструктор останавливает поток чтения и ждёт его; вызов read, уже заблокированный на вводе, при этом
+// дожидается своего завершения.
+class line_pipeline {
+public:
+    line_pipeline(read_function read, pipeline_options options) :
+        read_(std::move(read)), chunk_size_(std::max<std::size_t>(1, options.chunk_size)),
+        chunks_(std::max<std::size_t>(1, options.queue_depth) + 2) {
+        reader_ = std::jthread([this](std::stop_token stop) { read_loop(stop); });
+    }
+
+    line_pipeline(const line_pipeline&)            = delete;
+    line_pipeline& operator=(const line_pipeline&) = delete;
+
+    // Следующий кусок строк или nullptr в конце потока. Кусок, полученный предыдущим вызовом, возвращается стадии
+    // чтения, поэтому строки из него после этого недействительны.
+    const line_chunk* next() {
+        std::unique_lock lock {mutex_};
+        if(current_) {
+            free_.push_back(std::move(current_));
+            free_changed_.notify_one();
+        }
+        ready_changed_.wait(lock, [&] { return !ready_.empty() || closed_; });
+        if(ready_.empty()) {
+            return nullptr;
+        }
+        current_ = std::move(ready_.front());
+        ready_.pop_front();
+        return current_.get();
+    }
+
+    std::size_t chunk_size() const noexcept {
+        return chunk_size_;
+    }
+
+private:
+    using chunk_ptr = std::unique_ptr<line_chunk>;
+
+    // Свободный кусок для стадии чтения: ожидание, пока потребитель вернёт кусок, и есть обратное давление.
+    chunk_ptr acquire(std::stop_token stop) {
+        std::unique_lock lock {mutex_};
+        if(created_ < chunks_) {
+            ++created_;
+            return std::make_unique<line_chunk>(std::make_unique_for_overwrite<char[]>(chunk_size_));
+        }
+        if(!free_changed_.wait(lock, stop, [&] { return !free_.empty(); })) {
+            return nullptr;
+        }
+        auto chunk = std::move(free_.back());
+        free_.pop_back();
+        chunk->first = 0;
+        chunk->ends.clear();
+        chunk->error.reset();
+        return chunk;
+    }
+
+    void publish(chunk_ptr chunk) {
+        std::lock_guard lock {mutex_};
+        ready_.push_back(std::move(chunk));
+        ready_changed_.notify_one();
+    }
+
+    void close() {
+        std::lock_guard lock {mutex_};
+        closed_ = true;
+        ready_changed_.notify_one();
+    }
+
+    std::ptrdiff_t read_some(char* buffer, std::size_t size) {
+        try {
+            return read_(buffer, size);
+        }
+        catch(...) {
+            // Исключение не может покинуть поток чтения: оно сообщается потребителю как ошибка чтения.
+            return -1;
+        }
+    }
+
+    // Стадия чтения. Кусок отдаётся потребителю после каждого чтения, давшего хотя бы одну целую строку, а
+    // недочитанный хвост последней строки копируется в начало следующего куска.
+    void read_loop(std::stop_token stop) {
+        auto chunk           = acquire(stop);
+        std::size_t filled   = 0;  // Прочитано байт в текущий кусок.
+        std::size_t searched = 0;  // Граница, до которой '\n' уже искался.
+        bool skipping        = false;  // Отбрасывается хвост слишком длинной записи.
+        while(chunk && !stop.stop_requested()) {
+            const std::ptrdiff_t count = read_some(chunk->data.get() + filled, chunk_size_ - filled);
+            const bool eof             = count <= 0;
+            if(count < 0) {
+                chunk->error = scan_errc::stream_read_failed;
+            }
+            else {
+                filled += static_cast<std::size_t>(count);
+            }
+
+            while(const void* found = std::memchr(chunk->data.get() + searched, '\n', filled - searched)) {
+                const auto newline = static_cast<std::size_t>(static_cast<const char*>(found) - chunk->data.get());
+                if(skipping) {
+                    skipping     = false;
+                    chunk->first = newline + 1;
+                }
+                else {
+                    chunk->ends.push_back(newline);
+                }
+                searched = newline + 1;
+            }
+            searched = filled;
+
+            const std::size_t tail = chunk->ends.empty() ? chunk->first : chunk->ends.back() + 1;
+            if(eof) {
+                // Последняя запись без завершающего '\n'; после ошибки чтения недочитанная запись отбрасывается.
+                if(count == 0 && !skipping && tail < filled) {
+                    chunk->ends.push_back(filled);
+                }
+                publish(std::move(chunk));
+                break;
+            }
+            if(!chunk->ends.empty()) {
+                auto next = acquire(stop);
+                if(!next) {
+                    break;
+                }
+                filled = searched = filled - tail;
+                std::memcpy(next->data.get(), chunk->data.get() + tail, filled);
+                publish(std::move(chunk));
+                chunk = std::move(next);
+                continue;
+            }
+            if(filled < chunk_size_) {
+                continue;
+            }
+
+            // Кусок заполнен, а целых строк в нём нет.
+            if(skipping) {
+                filled = searched = 0;
+            }
+            else if(tail != 0) {
+                std::memmove(chunk->data.get(), chunk->data.get() + tail, filled - tail);
+                filled = searched = filled - tail;
+                chunk->first      = 0;
+            }
+            else {
+                // Запись не помещается в кусок: сообщаем об ошибке один раз и отбрасываем её до следующего '\n'.
+                chunk->error = scan_errc::record_too_long;
+                publish(std::move(chunk));
+                chunk  = acquire(stop);
+                filled = searched = 0;
+                skipping          = true;
+            }
+        }
+        close();
+    }
+
+    read_function read_;
+    std::size_t chunk_size_ = 0;
+    std::size_t chunks_     = 0;  // Всего кусков в обороте.
+    std::size_t created_    = 0;
+    std::mutex mutex_;
+    std::condition_variable_any free_changed_;
+    std::condition_variable ready_changed_;
+    std::vector<chunk_ptr> free_;  // Куски, возвращённые потребителем.
+    std::deque<chunk_ptr> ready_;  // Куски, ожидающие потребителя.
+    chunk_ptr current_;            // Кусок, строки которого сейчас читает потребитель.
+    bool closed_ = false;
+    std::jthread reader_;  // Объявлен последним: останавливается и присоединяется раньше разрушения остальных полей.
+};
+
+}  // namespace details
+
+#if defined(__cpp_lib_generator)
+
+// Генератор результатов scan_lines.
+template<typename... Ts>
+using scan_generator = std::generator<std::expected<details::scan_result<Ts...>, details::scan_error>>;
+
+// Конвейерное сканирование потока: поток чтения читает и режет данные на строки, пока вызывающий поток конвертирует
+// поля уже прочитанных строк. Результат обходится обычным for, а медленный обход приостанавливает чтение.
+//
+// Поля std::string_view в результате указывают в кусок чтения и действительны до перехода к следующей записи.
+// Ошибки ввода (scan_errc::stream_read_failed, scan_errc::record_too_long) выдаются на месте потока, где они
+// возникли; после ошибки чтения обход завершается.
+template<typename... Ts>
+scan_generator<Ts...> scan_lines(read_function read, scan_pattern<Ts...> pattern, pipeline_options options = {}) {
+    using value_type = std::expected<details::scan_result<Ts...>, details::scan_error>;
+    details::line_pipeline pipeline(std::move(read), options);
+    while(const auto* chunk = pipeline.next()) {
+        for(std::size_t i = 0; i < chunk->lines(); ++i) {
+            co_yield pattern.scan(chunk->line(i));
+        }
+        if(chunk->error) {
+            co_yield value_type {std::unexpect, chunk->error.value()};
+        }
+    }
+}
+
+// Конвейерное сканирование потока, данные которого поставляет функция read.
+template<typename... Ts>
+std::expected<scan_generator<Ts...>, details::scan_error> scan_lines(read_function read, std::string_view format,
+                                                                     pipeline_options options = {}) {
+    auto pattern = scan_pattern<Ts...>::compile(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return scan_lines<Ts...>(std::move(read), std::move(pattern.value()), options);
+}
+
+// Конвейерное сканирование std::istream. Поток должен оставаться живым на время обхода.
+template<typename... Ts>
+std::expected<scan_generator<Ts...>, details::scan_error> scan_lines(std::istream& input, std::string_view format,
+                                                                     pipeline_options options = {}) {
+    return scan_lines<Ts...>(details::istream_reader(input), format, options);
+}
+
+// Конвейерное сканирование файлового дескриптора. Дескриптор не закрывается.
+template<typename... Ts>
+std::expected<scan_generator<Ts...>, details::scan_error> scan_lines(int fd, std::string_view format,
+                                                                     pipeline_options options = {}) {
+    return scan_lines<Ts...>(details::fd_reader(fd), format, options);
+}
+
+#endif
+
+}  // namespace stdx
@@ -1,17 +1,24 @@
 #pragma once
 
+#include "config.hpp"
 #include "parse.hpp"
+#include "pattern.hpp"
+#include "scan_format.hpp"
+#include "stats.hpp"
 #include "types.hpp"
 
-namespace stdx {
+#if STDX_SCAN_ERASED
+#    include "erased.hpp"
+#endif
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
 
 using namespace std::literals;
 
 template<typename... Ts, std::size_t... Ids>
-constexpr std::expected<std::tuple<Ts...>, details::scan_error>
-populate_tuple_impl(const std::vector<std::string_view>& input_parts, const std::vector<std::string_view>& fmt_parts,
-                    std::index_sequence<Ids...>) {
-    std::tuple<Ts...> result;
+constexpr std::expected<void, details::scan_error>
+populate_tuple_impl(std::tuple<Ts...>& result, const details::fixed_parts<sizeof...(Ts)>& input_parts,
+                    const details::fixed_parts<sizeof...(Ts)>& fmt_parts, std::index_sequence<Ids...>) {
     bool success = true;
     details::scan_error error;
 
@@ -26,19 +33,23 @@ populate_tuple_impl(const std::vector<std::string_view>& input_parts, const std:
 
         if(i >= input_parts.size() || i >= fmt_parts.size()) {
             success = false;
-            error   = details::scan_error("Unexpected result. Index out of bounds during tuple population."s);
+            error   = details::scan_error(details::scan_errc::index_out_of_bounds);
             return;
         }
 
-        using TypeAtIndex = std::tuple_element_t<i, std::tuple<Ts...>>;
-        auto parse_result = details::parse_value_with_format<TypeAtIndex>(input_parts[i], fmt_parts[i]);
-
-        if(parse_result) {
-            std::get<i>(result) = std::move(parse_result.value());
-        }
-        else {
+        auto kind = details::parse_spec(fmt_parts[i]);
+        if(!kind) {
             success = false;
-            error   = parse_result.error();
+            error   = details::format_issue_error(kind.error());
+            return;
+        }
+
+        // Значение пишется прямо в элемент кортежа, чтобы строки std::pmr::string взяли память из его ресурса.
+        auto parse_result = details::convert_into(input_parts[i], kind.value(), std::get<i>(result));
+        if(!parse_result) {
+            success     = false;
+            error       = std::move(parse_result.error());
+            error.field = i;
         }
     };
 
@@ -47,45 +58,150 @@ populate_tuple_impl(const std::vector<std::string_view>& input_parts, const std:
     (process_element(std::integral_constant<std::size_t, Ids> {}), ...);
 
     if(success) {
-        return result;
+        return {};
     }
     else {
         return std::unexpected(std::move(error));
     }
 }
 
+// Заполнение кортежа на месте: значения пишутся прямо в result, без промежуточного кортежа и его перемещения.
 template<typename... Ts>
-constexpr std::expected<std::tuple<Ts...>, details::scan_error>
-populate_tuple(const std::vector<std::string_view>& input, const std::vector<std::string_view>& format) {
-    return populate_tuple_impl<Ts...>(input, format, std::index_sequence_for<Ts...> {});
+constexpr std::expected<void, details::scan_error> populate_tuple(std::tuple<Ts...>& result,
+                                                                  const details::fixed_parts<sizeof...(Ts)>& input,
+                                                                  const details::fixed_parts<sizeof...(Ts)>& format) {
+    return populate_tuple_impl<Ts...>(result, input, format, std::index_sequence_for<Ts...> {});
 }
 
-// замените болванку функции scan на рабочую версию
+namespace details {
+
+// Сканирование в заранее созданный результат scanResult.
 template<typename... Ts>
-constexpr std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input,
-                                                                               std::string_view format) {
-    // Получаем результат разбиения строк форматов и исходных данных.
-    auto parsed = details::parse_sources<Ts...>(input, format);
+constexpr std::expected<void, scan_error> scan_to(std::string_view input, std::string_view format,
+                                                  scan_result<Ts...>& scanResult) {
+#if STDX_SCAN_ERASED
+    if constexpr(is_erasable<Ts...>) {
+        if !consteval {
+            return scan_to_erased<Ts...>(input, format, scanResult);
+        }
+    }
+#endif
+    // Получаем результат разбиения строк форматов и исходных данных. Части хранятся в массивах фиксированного
+    // размера sizeof...(Ts), поэтому успешный путь для нестроковых типов не выделяет память.
+    scan_probe probe(format, input.size());
+    auto parsed = parse_sources<sizeof...(Ts)>(input, format);
     if(!parsed) {
-        return std::unexpected(details::scan_error(parsed.error().message));
+        probe.failed(parsed.error(), true);
+        return std::unexpected(std::move(parsed.error()));
     }
 
-    auto [fmt, data] = std::move(parsed.value());
+    const auto& [fmt, data] = parsed.value();
 
     // Число спецификаторов формата должно совпадать с числом шаблонных параметров ... Ts.
     if(fmt.size() != sizeof...(Ts)) {
-        return std::unexpected(
-            details::scan_error {"Unexpected result. Mismatched number of format specifiers and target types"s});
+        scan_error error(scan_errc::mismatched_count);
+        probe.failed(error, true);
+        return std::unexpected(std::move(error));
     }
+    probe.matched();
 
-    // Агрегируем результаты работы parse_value_with_format в объект типа scan_result.
-    auto populateResult = populate_tuple<Ts...>(data, fmt);
+    // Агрегируем сконвертированные значения прямо в объект типа scan_result.
+    auto populateResult = populate_tuple<Ts...>(scanResult.result, data, fmt);
     if(!populateResult) {
-        return std::unexpected(populateResult.error());
+        auto& error = populateResult.error();
+        if(error.field < sizeof...(Ts)) {
+            locate_field(error, error.field, input, data[error.field]);
+        }
+        probe.failed(error, false);
+        return std::unexpected(std::move(error));
     }
+    probe.succeeded();
+    return {};
+}
+
+}  // namespace details
+
+template<typename... Ts>
+constexpr std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input,
+                                                                               std::string_view format) {
     details::scan_result<Ts...> scanResult;
-    scanResult.result = std::move(populateResult.value());
+    if(auto scanned = details::scan_to<Ts...>(input, format, scanResult); !scanned) {
+        return std::unexpected(std::move(scanned.error()));
+    }
+    return scanResult;
+}
+
+// Перегрузка scan с ресурсом памяти: поля std::pmr::string берут память из resource, например из
+// std::pmr::monotonic_buffer_resource, который освобождается целиком после обработки пакета. Разбор формата
+// и сопоставление литералов памяти не выделяют.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input, std::string_view format,
+                                                                     std::pmr::memory_resource* resource) {
+    auto scanResult = details::make_scan_result<Ts...>(resource);
+    if(auto scanned = details::scan_to<Ts...>(input, format, scanResult); !scanned) {
+        return std::unexpected(std::move(scanned.error()));
+    }
+    return scanResult;
+}
+
+// Перегрузка scan для предварительно скомпилированного шаблона: форматная строка повторно не разбирается.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input,
+                                                                     const scan_pattern<Ts...>& pattern) {
+    return pattern.scan(input);
+}
 
-    return std::move(scanResult);
+// Перегрузка scan для скомпилированного шаблона с ресурсом памяти для полей std::pmr::string.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error>
+scan(std::string_view input, const scan_pattern<Ts...>& pattern, std::pmr::memory_resource* resource) {
+    return pattern.scan(input, resource);
+}
+
+// Перегрузка scan для форматной строки, проверенной при компиляции.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input,
+                                                                     const scan_format<Ts...>& format) {
+    return format.scan(input);
 }
+
+// Аналог std::format для scan: строковый литерал формата неявно превращается в scan_format<Ts...>, поэтому
+// несоответствие формата и типов Ts... обнаруживается при компиляции, а не в runtime.
+template<typename... Ts>
+std::expected<details::scan_result<Ts...>, details::scan_error>
+scan_checked(std::string_view input, scan_format<std::type_identity_t<Ts>...> format) {
+    return format.scan(input);
+}
+// Результат сканирования, поля которого (std::string_view, const char*) указывают во входную строку source.
+// Результат действителен, пока жив буфер, на который ссылается source.
+template<typename... Ts> struct borrowed_scan_result : details::scan_result<Ts...> {
+    std::string_view source {};
+};
+
+// Сканирование без копирования строковых полей: зависимость результата от входного буфера выражена в его типе.
+template<typename... Ts>
+constexpr std::expected<borrowed_scan_result<Ts...>, details::scan_error> scan_borrowed(std::string_view input,
+                                                                                        std::string_view format) {
+    auto scanned = scan<Ts...>(input, format);
+    if(!scanned) {
+        return std::unexpected(std::move(scanned.error()));
+    }
+    return borrowed_scan_result<Ts...> {std::move(scanned.value()), input};
+}
+
+template<typename... Ts>
+std::expected<borrowed_scan_result<Ts...>, details::scan_error> scan_borrowed(std::string_view input,
+                                                                              const scan_pattern<Ts...>& pattern) {
+    auto scanned = pattern.scan(input);
+    if(!scanned) {
+        return std::unexpected(std::move(scanned.error()));
+    }
+    return borrowed_scan_result<Ts...> {std::move(scanned.value()), input};
+}
+
+// Временная std::string умрёт раньше результата, поэтому заимствование из неё запрещено.
+template<typename... Ts, typename S, typename Format>
+    requires std::same_as<S, std::string>
+void scan_borrowed(S&& input, const Format& format) = delete;
+
 }  // namespace stdx
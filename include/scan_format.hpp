@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "config.hpp"
+#include "parse.hpp"
+#include "stats.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+namespace details {
+
+// Функции намеренно объявлены без constexpr и без определения: их вызов из consteval-конструктора scan_format
+// превращает ошибку форматной строки в ошибку компиляции, а имя функции в диагностике объясняет причину.
+void scan_format_has_unexpected_specifier();
+void scan_format_has_wrong_or_too_long_specifier();
+void scan_format_has_mismatched_number_of_placeholders();
+void scan_format_has_adjacent_placeholders();
+void scan_format_specifier_does_not_match_type();
+
+// Конверсия в T по виду спецификатора kind, совместимость которого с T уже проверена при компиляции. Ветви
+// несовместимых с T видов отбрасываются через if constexpr, и остаётся короткий switch из прямых вызовов convert_as.
+// Так конвертирует scan_format, у которого вид известен только объекту: форматная строка - аргумент конструктора,
+// как у std::format_string, и в тип не входит. Когда формат - параметр шаблона (scan_static), switch не нужен.
+template<typename T> constexpr std::expected<T, scan_error> convert_compatible(std::string_view input, spec_kind kind) {
+    switch(kind) {
+        case spec_kind::empty:
+            if constexpr(is_spec_compatible<T>(spec_kind::empty)) {
+                return convert_as<T, spec_kind::empty>(input);
+            }
+            break;
+        case spec_kind::string:
+            if constexpr(is_spec_compatible<T>(spec_kind::string)) {
+                return convert_as<T, spec_kind::string>(input);
+            }
+            break;
+        case spec_kind::integral:
+            if constexpr(is_spec_compatible<T>(spec_kind::integral)) {
+                return convert_as<T, spec_kind::integral>(input);
+            }
+            break;
+        case spec_kind::natural:
+            if constexpr(is_spec_compatible<T>(spec_kind::natural)) {
+                return convert_as<T, spec_kind::natural>(input);
+            }
+            break;
+        case spec_kind::floating:
+            if constexpr(is_spec_compatible<T>(spec_kind::floating)) {
+                return convert_as<T, spec_kind::floating>(input);
+            }
+            break;
+        case spec_kind::skip:
+            if constexpr(is_spec_compatible<T>(spec_kind::skip)) {
+                return convert_as<T, spec_kind::skip>(input);
+            }
+            break;
+    }
+    return std::unexpected(spec_mismatch_error<T>(kind));
+}
+
+// Подходит ли format для типов Ts...: те же проверки, что в конструкторе scan_format, но с ответом true/false, чтобы
+// ими можно было ограничить шаблон.
+template<typename... Ts> constexpr bool is_valid_scan_format(std::string_view format) {
+    auto layout = compile_layout<sizeof...(Ts)>(format);
+    if(!layout) {
+        return false;
+    }
+    return [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+        return (is_spec_compatible<Ts>(layout->entries[Ids].kind) && ...);
+    }(std::index_sequence_for<Ts...> {});
+}
+
+// Строковый литерал формата как параметр шаблона.
+template<std::size_t N> struct format_literal {
+    char value[N] {};
+
+    consteval format_literal(const char (&text)[N]) {
+        std::copy_n(text, N, value);
+    }
+
+    constexpr std::string_view view() const noexcept {
+        return {value, N - 1};
+    }
+};
+
+template<format_literal Format, typename... Ts> class static_format;
+
+}  // namespace details
+
+// Форматная строка, проверяемая при компиляции (аналог std::format_string). Смещения литеральных сегментов и вид
+// спецификатора каждого поля вычисляются в consteval-конструкторе, поэтому в runtime остаётся только сопоставление
+// литералов и конверсия значений.
+template<typename... Ts> class scan_format {
+public:
+    static constexpr std::size_t fields_count = sizeof...(Ts);
+
+    template<typename S>
+        requires std::convertible_to<const S&, std::string_view>
+    consteval scan_format(const S& format) : format_(format) {
+        auto layout = details::compile_layout<fields_count>(format_);
+        if(!layout) {
+            switch(layout.error()) {
+                case details::format_issue::unexpected_specifier:
+                    details::scan_format_has_unexpected_specifier();
+                    break;
+                case details::format_issue::wrong_specifier:
+                    details::scan_format_has_wrong_or_too_long_specifier();
+                    break;
+                case details::format_issue::mismatched_count:
+                    details::scan_format_has_mismatched_number_of_placeholders();
+                    break;
+                case details::format_issue::adjacent_placeholders:
+                    details::scan_format_has_adjacent_placeholders();
+                    break;
+            }
+        }
+        layout_ = layout.value();
+
+        [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+            (check_field<Ids>(), ...);
+        }(std::index_sequence_for<Ts...> {});
+    }
+
+    constexpr std::string_view get() const noexcept {
+        return format_;
+    }
+
+    // Сканирование входной строки: форматная строка уже разобрана, типы проверены при компиляции.
+    std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input) const {
+        details::scan_result<Ts...> scanResult;
+        if(auto scanned = scan_to(input, scanResult); !scanned) {
+            return std::unexpected(std::move(scanned.error()));
+        }
+        return scanResult;
+    }
+
+    // Сканирование с ресурсом памяти для полей std::pmr::string.
+    std::expected<details::scan_result<Ts...>, details::scan_error> scan(std::string_view input,
+                                                                         std::pmr::memory_resource* resource) const {
+        auto scanResult = details::make_scan_result<Ts...>(resource);
+        if(auto scanned = scan_to(input, scanResult); !scanned) {
+            return std::unexpected(std::move(scanned.error()));
+        }
+        return scanResult;
+    }
+
+private:
+    template<details::format_literal Format, typename... Us> friend class details::static_format;
+
+    // Kinds - виды спецификаторов как значение времени компиляции (для формата-параметра шаблона) либо nullptr,
+    // если они известны только этому объекту.
+    template<auto Kinds = nullptr>
+    std::expected<void, details::scan_error> scan_to(std::string_view input,
+                                                     details::scan_result<Ts...>& scanResult) const {
+        details::scan_probe probe(format_, input.size());
+        std::array<std::string_view, fields_count> fields;
+        if(auto matched = details::match_fields(input, format_, layout_, fields); !matched) {
+            probe.failed(matched.error(), true);
+            return std::unexpected(std::move(matched.error()));
+        }
+        probe.matched();
+
+        details::scan_error error;
+        auto convert_fields = [&]<std::size_t... Ids>(std::index_sequence<Ids...>) {
+            return (convert_field<Ids, Kinds>(input, fields[Ids], scanResult, error) && ...);
+        };
+        if(!convert_fields(std::index_sequence_for<Ts...> {})) {
+            probe.failed(error, false);
+            return std::unexpected(std::move(error));
+        }
+        probe.succeeded();
+        return {};
+    }
+
+    template<std::size_t I> constexpr void check_field() const {
+        using TypeAtIndex = std::tuple_element_t<I, std::tuple<Ts...>>;
+        if(!details::is_spec_compatible<TypeAtIndex>(layout_.entries[I].kind)) {
+            details::scan_format_specifier_does_not_match_type();
+        }
+    }
+
+    template<std::size_t I, auto Kinds>
+    bool convert_field(std::string_view input, std::string_view field, details::scan_result<Ts...>& scanResult,
+                       details::scan_error& error) const {
+        using TypeAtIndex          = std::tuple_element_t<I, std::tuple<Ts...>>;
+        constexpr bool kinds_known = !std::is_null_pointer_v<decltype(Kinds)>;
+        if constexpr(kinds_known) {
+            if constexpr(Kinds[I] == details::spec_kind::skip) {
+                return true;
+            }
+        }
+        else if(layout_.entries[I].kind == details::spec_kind::skip) {
+            return true;
+        }
+        if constexpr(details::is_pmr_string<TypeAtIndex>) {
+            // Строка заполняется на месте и берёт память из ресурса результата; вид спецификатора уже проверен.
+            std::get<I>(scanResult.result).assign(field);
+            return true;
+        }
+        else {
+            auto parse_result = [&] {
+                if constexpr(kinds_known) {
+                    return details::convert_as<TypeAtIndex, Kinds[I]>(field);
+                }
+                else {
+                    return details::convert_compatible<TypeAtIndex>(field, layout_.entries[I].kind);
+                }
+            }();
+            if(!parse_result) {
+                error = std::move(details::locate_field(parse_result.error(), I, input, field));
+                return false;
+            }
+            std::get<I>(scanResult.result) = std::move(parse_result.value());
+            return true;
+        }
+    }
+
+    std::string_view format_;
+    details::format_layout<fields_count> layout_ {};
+};
+
+namespace details {
+
+// Формат, заданный параметром шаблона: разобранное описание - статическая константа, и вид спецификатора каждого
+// поля становится параметром шаблона convert_as, так что конверсия поля - прямой вызов без выбора по виду в runtime.
+template<format_literal Format, typename... Ts> class static_format {
+public:
+    static std::expected<scan_result<Ts...>, scan_error> scan(std::string_view input) {
+        scan_result<Ts...> scanResult;
+        if(auto scanned = format.template scan_to<kinds>(input, scanResult); !scanned) {
+            return std::unexpected(std::move(scanned.error()));
+        }
+        return scanResult;
+    }
+
+private:
+    static constexpr scan_format<Ts...> format {Format.view()};
+    static constexpr auto kinds = format.layout_.kinds();
+};
+
+}  // namespace details
+
+// Сканирование по формату, заданному параметром шаблона: scan_static<"id={%d}", int>(input). Несоответствие формата
+// и типов отсекает ограничение шаблона, а каждое поле конвертируется без выбора по виду спецификатора в runtime.
+template<details::format_literal Format, typename... Ts>
+    requires(details::is_valid_scan_format<Ts...>(Format.view()))
+std::expected<details::scan_result<Ts...>, details::scan_error> scan_static(std::string_view input) {
+    return details::static_format<Format, Ts...>::scan(input);
+}
+
+}  // namespace stdx
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "config.hpp"
+#include "simd.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
+
+// Литералы не длиннее short_literal_limit ищутся векторным find_literal: каждый кандидат проверяется одним memcmp
+// не длиннее литерала, поэтому даже на неудачных данных работа ограничена short_literal_limit сравнениями на байт.
+// Для более длинных литералов такая оценка уже неприемлема, и они ищутся алгоритмом Two-Way.
+inline constexpr std::size_t short_literal_limit = 16;
+
+// Критическая факторизация литерала для Two-Way: литерал делится на левую и правую части в позиции critical,
+// period - сдвиг после совпадения правой части, memory - длина префикса, совпадение которого после такого сдвига
+// уже известно (0 для непериодичных литералов). Строится один раз на литерал за O(m).
+struct literal_plan {
+    std::size_t critical = 0;
+    std::size_t period   = 1;
+    std::size_t memory   = 0;
+};
+
+// Начало максимального суффикса needle и его период; reversed задаёт обратный порядок символов.
+constexpr std::pair<std::size_t, std::size_t> maximal_suffix(std::string_view needle, bool reversed) noexcept {
+    std::size_t suffix = 0;  // Начало суффикса + 1, чтобы обойтись без знаковой -1.
+    std::size_t j      = 0;
+    std::size_t k      = 1;
+    std::size_t period = 1;
+    while(j + k < needle.size()) {
+        const auto a = static_cast<unsigned char>(needle[suffix + k - 1]);
+        const auto b = static_cast<unsigned char>(needle[j + k]);
+        if(a == b) {
+            if(k == period) {
+                j += period;
+                k = 1;
+            }
+            else {
+                ++k;
+            }
+        }
+        else if(reversed ? a < b : a > b) {
+            j += k;
+            k      = 1;
+            period = j + 1 - suffix;
+        }
+        else {
+            suffix = j + 1;
+            ++j;
+            k = period = 1;
+        }
+    }
+    return {suffix, period};
+}
+
+constexpr literal_plan plan_literal(std::string_view needle) noexcept {
+    literal_plan plan;
+    if(needle.size() <= short_literal_limit) {
+        return plan;
+    }
+    const auto [forward, forward_period]   = maximal_suffix(needle, false);
+    const auto [backward, backward_period] = maximal_suffix(needle, true);
+    plan.critical = std::max(forward, backward);
+    plan.period   = forward >= backward ? forward_period : backward_period;
+
+    // Литерал периодичен, если левая часть повторяется через period: тогда после сдвига на период совпадение первых
+    // size - period символов уже известно. Иначе сдвиг после совпадения правой части может быть больше.
+    if(plan.period + plan.critical <= needle.size() &&
+       needle.substr(0, plan.critical) == needle.substr(plan.period, plan.critical)) {
+        plan.memory = needle.size() - plan.period;
+    }
+    else {
+        plan.period = std::max(plan.critical, needle.size() - plan.critical + 1);
+    }
+    return plan;
+}
+
+// Поиск первого вхождения needle алгоритмом Two-Way: линейное число сравнений без дополнительной памяти. Пока
+// совпадений нет, позиции-кандидаты перебираются векторным поиском куска литерала, поэтому на обычных данных
+// поиск идёт скачками, а в худшем случае каждый байт haystack просматривается ограниченное число раз.
+constexpr std::size_t two_way_find(std::string_view haystack, std::string_view needle,
+                                   const literal_plan& plan) noexcept {
+    const std::size_t length = needle.size();
+    if(haystack.size() < length) {
+        return std::string_view::npos;
+    }
+    // Кусок needle длиной до short_literal_limit, заканчивающийся символом critical: им ищутся кандидаты, и поиск
+    // повторно просматривает не больше short_literal_limit уже сравнённых символов haystack.
+    const std::size_t probe_offset = plan.critical + 1 > short_literal_limit ? plan.critical + 1 - short_literal_limit
+                                                                             : 0;
+    const auto probe               = needle.substr(probe_offset, short_literal_limit);
+
+    std::size_t position = find_literal(haystack.substr(probe_offset), probe);
+    std::size_t memory   = 0;
+    while(position != std::string_view::npos && position + length <= haystack.size()) {
+        // Правая часть сравнивается слева направо; несовпадение на k позволяет сдвинуться за него. Сначала она
+        // сравнивается целиком, и только при несовпадении ищется его место.
+        std::size_t k = std::max(plan.critical, memory);
+        if(needle.substr(k) == haystack.substr(position + k, length - k)) {
+            k = length;
+        }
+        for(; k < length && needle[k] == haystack[position + k]; ++k) {}
+        if(k < length) {
+            if(memory == 0 && k == plan.critical) {
+                // Несовпадение на первом же символе: ближайший кандидат - следующее вхождение probe, которое ищет
+                // векторный find_literal.
+                auto next = find_literal(haystack.substr(position + probe_offset + 1), probe);
+                position  = next == std::string_view::npos ? next : position + next + 1;
+            }
+            else {
+                position += k - plan.critical + 1;
+            }
+            memory = 0;
+            continue;
+        }
+        // Левая часть, кроме префикса memory, совпадение которого уже известно. Место несовпадения в ней не нужно:
+        // сдвиг после него всегда равен периоду.
+        const std::size_t left = plan.critical - std::min(plan.critical, memory);
+        if(left == 0 || needle.substr(memory, left) == haystack.substr(position + memory, left)) {
+            return position;
+        }
+        position += plan.period;
+        memory = plan.memory;
+    }
+    return std::string_view::npos;
+}
+
+// Поиск первого вхождения литерала, эквивалентный std::string_view::find, с линейной оценкой по длине haystack
+// независимо от содержимого. plan - факторизация needle, построенная plan_literal.
+constexpr std::size_t find_literal_linear(std::string_view haystack, std::string_view needle,
+                                          const literal_plan& plan) noexcept {
+    if(needle.size() <= short_literal_limit) {
+        return find_literal(haystack, needle);
+    }
+    return two_way_find(haystack, needle, plan);
+}
+
+// Вариант для литерала без заранее построенной факторизации: она строится на месте за O(m) без выделения памяти.
+constexpr std::size_t find_literal_linear(std::string_view haystack, std::string_view needle) noexcept {
+    if(needle.size() <= short_literal_limit) {
+        return find_literal(haystack, needle);
+    }
+    return two_way_find(haystack, needle, plan_literal(needle));
+}
+
+}  // namespace stdx::details
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "config.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#    define STDX_SCAN_X86 1
+#    include <immintrin.h>
+#endif
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
+
+// Результат поиска литерала в пределах строки: позиция литерала либо позиция '\n', встреченного раньше него.
+struct line_hit {
+    std::size_t position = std::string_view::npos;
+    bool newline         = false;
+};
+
+// Скалярный поиск литерала needle в haystack. При stop_at_newline поиск прекращается на первом '\n'.
+inline line_hit find_literal_scalar(const char* haystack, std::size_t size, const char* needle, std::size_t length,
+                                    std::size_t from, bool stop_at_newline) noexcept {
+    for(std::size_t i = from; i + length <= size; ++i) {
+        if(stop_at_newline && haystack[i] == '\n') {
+            return {i, true};
+        }
+        if(haystack[i] == needle[0] && std::memcmp(haystack + i + 1, needle + 1, length - 1) == 0) {
+            return {i, false};
+        }
+    }
+    if(stop_at_newline) {
+        // Литерал уже не помещается, но '\n' ещё может встретиться в хвосте.
+        if(const void* newline = std::memchr(haystack + from, '\n', size - std::min(from, size))) {
+            return {static_cast<std::size_t>(static_cast<const char*>(newline) - haystack), true};
+        }
+    }
+    return {};
+}
+
+#ifdef STDX_SCAN_X86
+
+// Векторный поиск литерала: в каждом блоке одновременно сравниваются первый и последний байты литерала, а кандидаты
+// проверяются memcmp. При stop_at_newline в том же проходе ищется '\n', и побеждает то, что встретилось раньше.
+// Vec задаёт ширину регистра (SSE2 или AVX2) и возвращает только битовые маски, поэтому векторные типы не пересекают
+// границы функций с разными целевыми наборами инструкций.
+template<typename Vec>
+inline line_hit find_literal_blocks(const char* haystack, std::size_t size, const char* needle, std::size_t length,
+                                    bool stop_at_newline) noexcept {
+    const char first = needle[0];
+    const char last  = needle[length - 1];
+
+    std::size_t i = 0;
+    for(; i + length - 1 + Vec::width <= size; i += Vec::width) {
+        auto candidates = Vec::equal_mask(haystack + i, first) & Vec::equal_mask(haystack + i + length - 1, last);
+        auto newlines   = stop_at_newline ? Vec::equal_mask(haystack + i, '\n') : 0u;
+
+        while((candidates | newlines) != 0) {
+            const auto bit = static_cast<std::size_t>(__builtin_ctz(candidates | newlines));
+            if((newlines >> bit) & 1u) {
+                return {i + bit, true};
+            }
+            if(length <= 2 || std::memcmp(haystack + i + bit + 1, needle + 1, length - 2) == 0) {
+                return {i + bit, false};
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    return find_literal_scalar(haystack, size, needle, length, i, stop_at_newline);
+}
+
+struct sse2_vec {
+    static constexpr std::size_t width = 16;
+
+    // Маска байтов блока, равных c: бит k установлен, если p[k] == c.
+    static unsigned equal_mask(const char* p, char c) noexcept {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c))));
+    }
+};
+
+struct avx2_vec {
+    static constexpr std::size_t width = 32;
+
+    __attribute__((target("avx2"))) static unsigned equal_mask(const char* p, char c) noexcept {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(c))));
+    }
+};
+
+inline line_hit find_literal_sse2(const char* haystack, std::size_t size, const char* needle, std::size_t length,
+                                  bool stop_at_newline) noexcept {
+    return find_literal_blocks<sse2_vec>(haystack, size, needle, length, stop_at_newline);
+}
+
+// flatten встраивает общий цикл и методы avx2_vec в эту функцию, собранную с поддержкой AVX2.
+__attribute__((target("avx2"), flatten)) inline line_hit find_literal_avx2(const char* haystack, std::size_t size,
+                                                                           const char* needle, std::size_t length,
+                                                                           bool stop_at_newline) noexcept {
+    return find_literal_blocks<avx2_vec>(haystack, size, needle, length, stop_at_newline);
+}
+
+#endif
+
+using find_literal_fn = line_hit (*)(const char*, std::size_t, const char*, std::size_t, bool) noexcept;
+
+inline line_hit find_literal_fallback(const char* haystack, std::size_t size, const char* needle, std::size_t length,
+                                      bool stop_at_newline) noexcept {
+    return find_literal_scalar(haystack, size, needle, length, 0, stop_at_newline);
+}
+
+// Выбор реализации поиска по возможностям процессора; выполняется один раз при первом вызове.
+inline find_literal_fn select_find_literal() noexcept {
+#ifdef STDX_SCAN_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        return &find_literal_avx2;
+    }
+    return &find_literal_sse2;
+#else
+    return &find_literal_fallback;
+#endif
+}
+
+inline line_hit find_literal_dispatch(std::string_view haystack, std::string_view needle,
+                                      bool stop_at_newline) noexcept {
+    if(needle.empty()) {
+        return {0, false};
+    }
+    if(needle.size() > haystack.size()) {
+        return stop_at_newline ? find_literal_scalar(haystack.data(), haystack.size(), needle.data(), needle.size(),
+                                                     0, true)
+                               : line_hit {};
+    }
+    // Одиночный байт вне построчного режима быстрее всего ищет memchr стандартной библиотеки.
+    if(needle.size() == 1 && !stop_at_newline) {
+        const void* found = std::memchr(haystack.data(), needle[0], haystack.size());
+        return {found == nullptr ? std::string_view::npos
+                                 : static_cast<std::size_t>(static_cast<const char*>(found) - haystack.data()),
+                false};
+    }
+    static const find_literal_fn impl = select_find_literal();
+    return impl(haystack.data(), haystack.size(), needle.data(), needle.size(), stop_at_newline);
+}
+
+// Поиск первого вхождения литерала, эквивалентный std::string_view::find.
+constexpr std::size_t find_literal(std::string_view haystack, std::string_view needle) noexcept {
+    if consteval {
+        return haystack.find(needle);
+    }
+    else {
+        return find_literal_dispatch(haystack, needle, false).position;
+    }
+}
+
+// Поиск литерала в пределах строки: возвращает позицию литерала, либо позицию '\n' с newline = true, если строка
+// закончилась раньше, либо npos, если нет ни того, ни другого. Литерал не должен содержать '\n'.
+inline line_hit find_literal_in_line(std::string_view haystack, std::string_view needle) noexcept {
+    return find_literal_dispatch(haystack, needle, true);
+}
+
+}  // namespace stdx::details
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "config.hpp"
+#include "types.hpp"
+
+// Статистика сканирования включается определением STDX_SCAN_STATS=1 (опция CMake STDX_SCAN_STATS). Без него
+// счётчики и замеры времени не компилируются, а снимок статистики всегда пуст. Счётчики вызовов, ошибок и байтов
+// точные, а время замеряется в одном вызове из STDX_SCAN_STATS_SAMPLE, поскольку чтение часов дороже разбора
+// короткой строки. Первый вызов с новым форматом в потоке выделяет память под его счётчики. Значение макроса входит
+// в имена типов библиотеки (см. config.hpp), поэтому смешать единицы трансляции с разными значениями не удастся.
+
+#ifndef STDX_SCAN_STATS_SAMPLE
+#    define STDX_SCAN_STATS_SAMPLE 64
+#endif
+
+#if STDX_SCAN_STATS
+#    include <algorithm>
+#    include <atomic>
+#    include <chrono>
+#    include <map>
+#    include <memory>
+#    include <mutex>
+#endif
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Накопленная статистика одного формата. Счётчики только растут с запуска процесса, поэтому снимки удобно
+// экспортировать в системы метрик как монотонные счётчики.
+struct scan_stats {
+    std::string format;
+    std::uint64_t calls      = 0;  // Вызовы сканирования с этим форматом.
+    std::uint64_t failures   = 0;  // Из них завершились ошибкой.
+    std::uint64_t bytes      = 0;  // Суммарная длина входных строк.
+    std::uint64_t timed      = 0;  // Вызовы, в которых замерялось время.
+    std::uint64_t match_ns   = 0;  // Время поиска литералов и выделения полей в замеренных вызовах.
+    std::uint64_t convert_ns = 0;  // Время конверсии полей в замеренных вызовах.
+
+    // Число ошибок по кодам scan_errc.
+    std::array<std::uint64_t, details::scan_errc_count> errors {};
+};
+
+constexpr bool scan_stats_enabled = STDX_SCAN_STATS != 0;
+
+namespace details {
+
+#if STDX_SCAN_STATS
+
+// Счётчики формата в одном потоке. Пишет в них только поток-владелец (загрузка и сохранение без атомарного
+// инкремента), а остальные потоки лишь читают их при снятии снимка, поэтому горячий путь не содержит блокировок.
+struct stats_counters {
+    std::atomic<std::uint64_t> calls {0};
+    std::atomic<std::uint64_t> failures {0};
+    std::atomic<std::uint64_t> bytes {0};
+    std::atomic<std::uint64_t> timed {0};
+    std::atomic<std::uint64_t> match_ns {0};
+    std::atomic<std::uint64_t> convert_ns {0};
+    std::array<std::atomic<std::uint64_t>, scan_errc_count> errors {};
+
+    void add_to(scan_stats& stats) const noexcept {
+        stats.calls += calls.load(std::memory_order_relaxed);
+        stats.failures += failures.load(std::memory_order_relaxed);
+        stats.bytes += bytes.load(std::memory_order_relaxed);
+        stats.timed += timed.load(std::memory_order_relaxed);
+        stats.match_ns += match_ns.load(std::memory_order_relaxed);
+        stats.convert_ns += convert_ns.load(std::memory_order_relaxed);
+        for(std::size_t i = 0; i < scan_errc_count; ++i) {
+            stats.errors[i] += errors[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t delta) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+struct stats_block;
+
+// Глобальный реестр: номера форматов, счётчики живых потоков и итоги завершившихся потоков.
+struct stats_registry {
+    std::mutex mutex;
+    std::map<std::string, std::size_t, std::less<>> ids;
+    std::vector<const std::string*> formats;  // Текст формата по номеру; указывает в ключи ids.
+    std::vector<stats_block*> threads;
+    std::vector<scan_stats> retired;
+};
+
+inline stats_registry& registry() {
+    static stats_registry instance;
+    return instance;
+}
+
+// Счётчики всех форматов в одном потоке. При завершении потока они переносятся в итоги реестра.
+struct stats_block {
+    std::vector<std::unique_ptr<stats_counters>> counters;
+
+    stats_block() {
+        auto& reg = registry();
+        std::lock_guard lock {reg.mutex};
+        reg.threads.push_back(this);
+    }
+
+    ~stats_block() {
+        auto& reg = registry();
+        std::lock_guard lock {reg.mutex};
+        for(std::size_t id = 0; id < counters.size(); ++id) {
+            counters[id]->add_to(reg.retired[id]);
+        }
+        std::erase(reg.threads, this);
+    }
+
+    stats_counters& at(std::size_t id) {
+        if(id >= counters.size()) [[unlikely]] {
+            // Рост под мьютексом реестра, чтобы снимок не читал вектор во время перевыделения.
+            std::lock_guard lock {registry().mutex};
+            while(counters.size() <= id) {
+                counters.push_back(std::make_unique<stats_counters>());
+            }
+        }
+        return *counters[id];
+    }
+};
+
+inline stats_block& thread_stats() {
+    thread_local stats_block block;
+    return block;
+}
+
+// Ключ статистики: номер формата в реестре.
+struct stats_key {
+    std::size_t id = static_cast<std::size_t>(-1);
+};
+
+// Номер формата в реестре; новый формат регистрируется под мьютексом.
+inline stats_key register_format(std::string_view format) {
+    auto& reg = registry();
+    std::lock_guard lock {reg.mutex};
+    auto it = reg.ids.find(format);
+    if(it == reg.ids.end()) {
+        it = reg.ids.emplace(std::string {format}, reg.formats.size()).first;
+        reg.formats.push_back(&it->first);
+        reg.retired.push_back(scan_stats {});
+    }
+    return {it->second};
+}
+
+// Номер формата через небольшой кэш потока с прямым отображением по адресу строки. Совпадение адреса
+// перепроверяется сравнением текста, поэтому переиспользованный буфер с другим форматом не смешивает статистику.
+inline stats_key format_key(std::string_view format) {
+    struct entry {
+        const char* data        = nullptr;
+        const std::string* text = nullptr;  // Зарегистрированный текст формата; узлы реестра не перемещаются.
+        stats_key key {};
+    };
+    thread_local std::array<entry, 64> cache {};
+
+    auto& slot = cache[(reinterpret_cast<std::uintptr_t>(format.data()) >> 3) % cache.size()];
+    if(slot.text != nullptr && slot.data == format.data() && *slot.text == format) [[likely]] {
+        return slot.key;
+    }
+    const auto key = register_format(format);
+    std::lock_guard lock {registry().mutex};
+    slot = entry {format.data(), registry().formats[key.id], key};
+    return key;
+}
+
+// Замер одного вызова сканирования: время до matched() относится к выделению полей, после - к конверсии.
+class scan_probe {
+public:
+    using clock = std::chrono::steady_clock;
+
+    constexpr scan_probe(stats_key key, std::size_t bytes) {
+        if !consteval {
+            start(key, bytes);
+        }
+    }
+
+    constexpr scan_probe(std::string_view format, std::size_t bytes) {
+        if !consteval {
+            start(format_key(format), bytes);
+        }
+    }
+
+    constexpr void matched() noexcept {
+        if !consteval {
+            if(timed_) {
+                const auto now = clock::now();
+                bump(counters_->match_ns, elapsed(now));
+                phase_start_ = now;
+            }
+        }
+    }
+
+    constexpr void succeeded() noexcept {
+        if !consteval {
+            finish(counters_->convert_ns);
+        }
+    }
+
+    // Ошибка на этапе выделения полей (matching = true) или конверсии.
+    constexpr void failed(const scan_error& error, bool matching) noexcept {
+        if !consteval {
+            bump(counters_->failures, 1);
+            bump(counters_->errors[static_cast<std::size_t>(error.code)], 1);
+            finish(matching ? counters_->match_ns : counters_->convert_ns);
+        }
+    }
+
+private:
+    void start(stats_key key, std::size_t bytes) {
+        counters_        = &thread_stats().at(key.id);
+        const auto calls = counters_->calls.load(std::memory_order_relaxed);
+        counters_->calls.store(calls + 1, std::memory_order_relaxed);
+        bump(counters_->bytes, bytes);
+        timed_ = calls % STDX_SCAN_STATS_SAMPLE == 0;
+        if(timed_) {
+            bump(counters_->timed, 1);
+            phase_start_ = clock::now();
+        }
+    }
+
+    void finish(std::atomic<std::uint64_t>& phase) noexcept {
+        if(timed_) {
+            bump(phase, elapsed(clock::now()));
+        }
+    }
+
+    std::uint64_t elapsed(clock::time_point now) const noexcept {
+        const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - phase_start_);
+        return static_cast<std::uint64_t>(duration.count());
+    }
+
+    stats_counters* counters_ = nullptr;  // В рантайме всегда указывает на счётчики формата в текущем потоке.
+    clock::time_point phase_start_ {};
+    bool timed_ = false;
+};
+
+#else
+
+// Без STDX_SCAN_STATS ключ и замер пусты, а их методы не генерируют кода.
+struct stats_key {};
+
+inline constexpr stats_key register_format(std::string_view) noexcept {
+    return {};
+}
+
+class scan_probe {
+public:
+    constexpr scan_probe(stats_key, std::size_t) noexcept {}
+    constexpr scan_probe(std::string_view, std::size_t) noexcept {}
+    constexpr void matched() noexcept {}
+    constexpr void succeeded() noexcept {}
+    constexpr void failed(const scan_error&, bool) noexcept {}
+};
+
+#endif
+
+}  // namespace details
+
+// Снимок статистики всех форматов, сканировавшихся с запуска процесса: суммы по живым и завершившимся потокам.
+// Без STDX_SCAN_STATS всегда пуст.
+inline std::vector<scan_stats> scan_stats_snapshot() {
+#if STDX_SCAN_STATS
+    auto& reg = details::registry();
+    std::lock_guard lock {reg.mutex};
+    std::vector<scan_stats> snapshot = reg.retired;
+    for(std::size_t id = 0; id < snapshot.size(); ++id) {
+        snapshot[id].format = *reg.formats[id];
+    }
+    for(const auto* block : reg.threads) {
+        for(std::size_t id = 0; id < block->counters.size(); ++id) {
+            block->counters[id]->add_to(snapshot[id]);
+        }
+    }
+    return snapshot;
+#else
+    return {};
+#endif
+}
+
+}  // namespace stdx
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <unistd.h>
+
+#include "config.hpp"
+#include "pattern.hpp"
+#include "types.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Функция чтения из потока: записывает до size байт в buffer и возвращает число прочитанных байт, 0 в конце потока
+// или отрицательное значение при ошибке.
+using read_function = std::move_only_function<std::ptrdiff_t(char* buffer, std::size_t size)>;
+
+namespace details {
+
+// Функция чтения из std::istream. Поток должен оставаться живым, пока функция используется.
+inline read_function istream_reader(std::istream& input) {
+    return [&input](char* buffer, std::size_t size) -> std::ptrdiff_t {
+        input.read(buffer, static_cast<std::streamsize>(size));
+        if(input.bad()) {
+            return -1;
+        }
+        return static_cast<std::ptrdiff_t>(input.gcount());
+    };
+}
+
+// Функция чтения из файлового дескриптора с повтором прерванных сигналом вызовов.
+inline read_function fd_reader(int fd) {
+    return [fd](char* buffer, std::size_t size) -> std::ptrdiff_t {
+        while(true) {
+            const auto count = ::read(fd, buffer, size);
+            if(count >= 0 || errno != EINTR) {
+                return count;
+            }
+        }
+    };
+}
+
+}  // namespace details
+
+// Построчное сканирование потока, который нельзя получить одним буфером (каналы, сокеты, std::istream). Данные
+// читаются кусками в буфер фиксированной ёмкости, поэтому расход памяти не зависит от длины потока. Запись,
+// разрезанная границей куска, не копируется отдельно: перед чтением следующего куска недочитанный хвост один раз
+// сдвигается в начало буфера. Запись длиннее буфера пропускается с ошибкой scan_errc::record_too_long.
+//
+// Диапазон однопроходный: поля std::string_view в результате указывают в буфер и действительны до перехода к
+// следующей записи.
+template<typename... Ts> class stream_scan {
+public:
+    using value_type = std::expected<details::scan_result<Ts...>, details::scan_error>;
+
+    static constexpr std::size_t default_capacity = 64 * 1024;
+
+    class iterator {
+    public:
+        using value_type      = stream_scan::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        const value_type& operator*() const noexcept {
+            return owner_->current_;
+        }
+
+        const value_type* operator->() const noexcept {
+            return &owner_->current_;
+        }
+
+        iterator& operator++() {
+            owner_->advance();
+            return *this;
+        }
+
+        void operator++(int) {
+            owner_->advance();
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+            return it.finished();
+        }
+
+    private:
+        friend class stream_scan;
+
+        explicit iterator(stream_scan* owner) : owner_(owner) {}
+
+        bool finished() const noexcept {
+            return owner_->done_;
+        }
+
+        stream_scan* owner_ = nullptr;
+    };
+
+    stream_scan(read_function read, scan_pattern<Ts...> pattern, std::size_t capacity = default_capacity) :
+        read_(std::move(read)), pattern_(std::move(pattern)), buffer_(std::make_unique_for_overwrite<char[]>(capacity)),
+        capacity_(capacity) {}
+
+    // Первая запись читается при вызове begin(), поэтому диапазон обходится один раз.
+    iterator begin() {
+        if(!started_) {
+            started_ = true;
+            advance();
+        }
+        return iterator {this};
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return {};
+    }
+
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    // Переход к следующей записи потока и её сканирование.
+    void advance() {
+        while(true) {
+            if(done_) {
+                return;
+            }
+
+            // Поиск конца записи продолжается с места, где остановился предыдущий поиск.
+            const char* newline =
+                static_cast<const char*>(std::memchr(buffer_.get() + searched_, '\n', end_ - searched_));
+            if(newline != nullptr) {
+                const auto line_end = static_cast<std::size_t>(newline - buffer_.get());
+                const auto line     = std::string_view {buffer_.get() + begin_, line_end - begin_};
+                begin_ = searched_ = line_end + 1;
+                if(skipping_) {
+                    // Окончание слишком длинной записи, о которой уже сообщено.
+                    skipping_ = false;
+                    continue;
+                }
+                current_ = pattern_.scan(line);
+                return;
+            }
+            searched_ = end_;
+
+            if(eof_) {
+                done_ = begin_ == end_ || skipping_;
+                if(!done_) {
+                    // Последняя запись без завершающего '\n'.
+                    current_ = pattern_.scan(std::string_view {buffer_.get() + begin_, end_ - begin_});
+                    begin_ = searched_ = end_;
+                }
+                return;
+            }
+
+            compact();
+            if(end_ == capacity_) {
+                // Запись не помещается в буфер: сообщаем об ошибке один раз и отбрасываем её до следующего '\n'.
+                end_ = searched_ = 0;
+                if(!skipping_) {
+                    skipping_ = true;
+                    current_  = std::unexpected(details::scan_error(details::scan_errc::record_too_long));
+                    return;
+                }
+            }
+            if(!fill()) {
+                return;
+            }
+        }
+    }
+
+    // Перенос недочитанного хвоста в начало буфера, чтобы освободить место для следующего куска.
+    void compact() noexcept {
+        if(begin_ == 0) {
+            return;
+        }
+        std::memmove(buffer_.get(), buffer_.get() + begin_, end_ - begin_);
+        end_ -= begin_;
+        searched_ -= begin_;
+        begin_ = 0;
+    }
+
+    // Чтение следующего куска. При ошибке чтения она становится текущим результатом, и обход завершается.
+    bool fill() {
+        const std::ptrdiff_t count = read_(buffer_.get() + end_, capacity_ - end_);
+        if(count < 0) {
+            current_ = std::unexpected(details::scan_error(details::scan_errc::stream_read_failed));
+            eof_     = true;
+            begin_ = searched_ = end_;
+            skipping_          = true;
+            return false;
+        }
+        if(count == 0) {
+            eof_ = true;
+        }
+        end_ += static_cast<std::size_t>(count);
+        return true;
+    }
+
+    read_function read_;
+    scan_pattern<Ts...> pattern_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t capacity_ = 0;
+    std::size_t begin_    = 0;  // Начало текущей записи.
+    std::size_t searched_ = 0;  // Граница, до которой '\n' уже искался.
+    std::size_t end_      = 0;  // Конец прочитанных данных.
+    bool started_         = false;
+    bool eof_             = false;
+    bool skipping_        = false;  // Отбрасывается хвост слишком длинной записи.
+    bool done_            = false;
+    value_type current_ {};
+};
+
+// Сканирование потока, данные которого поставляет функция read.
+template<typename... Ts>
+std::expected<stream_scan<Ts...>, details::scan_error>
+scan_stream(read_function read, std::string_view format,
+            std::size_t capacity = stream_scan<Ts...>::default_capacity) {
+    auto pattern = scan_pattern<Ts...>::compile(format);
+    if(!pattern) {
+        return std::unexpected(std::move(pattern.error()));
+    }
+    return std::expected<stream_scan<Ts...>, details::scan_error> {
+        std::in_place, std::move(read), std::move(pattern.value()), std::max<std::size_t>(1, capacity)};
+}
+
+// Сканирование std::istream. Поток должен оставаться живым на время обхода.
+template<typename... Ts>
+std::expected<stream_scan<Ts...>, details::scan_error>
+scan_stream(std::istream& input, std::string_view format,
+            std::size_t capacity = stream_scan<Ts...>::default_capacity) {
+    return scan_stream<Ts...>(details::istream_reader(input), format, capacity);
+}
+
+// Сканирование файлового дескриптора (канала, сокета, файла). Дескриптор не закрывается.
+template<typename... Ts>
+std::expected<stream_scan<Ts...>, details::scan_error>
+scan_stream(int fd, std::string_view format, std::size_t capacity = stream_scan<Ts...>::default_capacity) {
+    return scan_stream<Ts...>(details::fd_reader(fd), format, capacity);
+}
+
+}  // namespace stdx
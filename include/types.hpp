@@ -1,6 +1,26 @@
 #pragma once
 
-namespace stdx::details {
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "config.hpp"
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE {
+
+// Тип поля для плейсхолдера {*}: значение поля сопоставляется с входной строкой, но не конвертируется.
+struct skip {
+    friend constexpr bool operator==(skip, skip) noexcept = default;
+};
+
+}  // namespace stdx
+
+namespace stdx::inline STDX_SCAN_ABI_NAMESPACE::details {
 
 // Концепты для проверок соответствия типов. В том числе поддержка cv-квалификаторов типов.
 template<typename... T>
@@ -21,9 +41,134 @@ concept is_string = (std::same_as<std::string, T> && ...);
 template<typename... T>
 concept is_string_view = (std::same_as<std::string_view, T> && ...);
 
-// Класс для хранения ошибки неуспешного сканирования.
+template<typename... T>
+concept is_pmr_string = (std::same_as<std::pmr::string, T> && ...);
+
+// Вид спецификатора формата внутри плейсхолдера: {}, {%s}, {%d}, {%u}, {%f}. Ширина поля ({%8d}) хранится отдельно.
+enum class spec_kind : unsigned char {
+    empty,
+    string,
+    integral,
+    natural,
+    floating,
+    skip,  // {*}: поле пропускается без конверсии.
+};
+
+// Причины, по которым форматная строка не может быть скомпилирована.
+enum class format_issue : unsigned char {
+    unexpected_specifier,   // Неизвестный символ спецификатора, например {%x}.
+    wrong_specifier,        // Спецификатор без префикса % или длиннее одного символа.
+    mismatched_count,       // Число плейсхолдеров не совпадает с числом типов.
+    adjacent_placeholders,  // Плейсхолдеры без литерала между ними.
+};
+
+// Коды ошибок сканирования. Текст ошибки по коду строится только по запросу в scan_error::message().
+enum class scan_errc : unsigned char {
+    unexpected_specifier,          // Неизвестный символ спецификатора, например {%x}.
+    wrong_specifier,               // Спецификатор без префикса % или длиннее одного символа.
+    mismatched_count,              // Число плейсхолдеров не совпадает с числом типов.
+    index_out_of_bounds,           // Плейсхолдеры без литерала между ними.
+    literal_mismatch,              // Литерал формата не найден во входной строке.
+    unsupported_type,              // Тип поля не поддерживается плейсхолдером {}.
+    string_type_mismatch,          // {%s} для нестрокового типа.
+    integral_type_mismatch,        // {%d} для нецелого типа.
+    natural_type_mismatch,         // {%u} для типа, не являющегося беззнаковым целым.
+    floating_type_mismatch,        // {%f} для типа без плавающей или фиксированной точки.
+    invalid_integer,               // Значение {%d} или {%u} не разобрано как type_name.
+    invalid_floating,              // Значение {%f} не разобрано как type_name.
+    invalid_integer_placeholder,   // Значение {} не разобрано как целое type_name.
+    integer_out_of_range,          // Значение {} вне диапазона знакового целого типа поля.
+    negative_unsigned,             // Отрицательное значение {} для беззнакового типа поля.
+    unsigned_out_of_range,         // Значение {} вне диапазона беззнакового целого типа поля.
+    invalid_decimal_placeholder,   // Значение {} не разобрано как число с фиксированной точкой.
+    invalid_floating_placeholder,  // Значение {} не разобрано как число с плавающей точкой type_name.
+    floating_out_of_range,         // Значение {} вне диапазона float.
+    file_open_failed,              // Файл context не открыт.
+    file_stat_failed,              // Размер файла context не получен.
+    file_map_failed,               // Файл context не отображён в память.
+    stream_read_failed,            // Ошибка чтения из потока.
+    record_too_long,               // Запись потока не помещается в буфер чтения.
+    field_too_short,               // Входная строка короче поля фиксированной ширины.
+};
+
+// Число кодов scan_errc; должно указывать за последний код перечисления.
+inline constexpr std::size_t scan_errc_count = static_cast<std::size_t>(scan_errc::field_too_short) + 1;
+
+// Класс для хранения ошибки неуспешного сканирования. Конструирование ошибки не выделяет память: хранится только код,
+// индекс поля и смещение во входной строке, а текст собирается лениво в message().
 struct scan_error {
-    std::string message {};
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    scan_errc code {};
+    std::size_t field     = npos;     // Индекс поля; для literal_mismatch - индекс ненайденного литерала.
+    std::size_t offset    = npos;     // Смещение поля (или начала поиска литерала) во входной строке.
+    const char* type_name = nullptr;  // Имя целевого типа в ошибках конверсии; строка со статическим временем жизни.
+    std::string context {};           // Путь к файлу в ошибках ввода-вывода, в остальных случаях пуст.
+
+    constexpr scan_error() = default;
+
+    constexpr explicit scan_error(scan_errc code, const char* type_name = nullptr) :
+        code(code), type_name(type_name) {}
+
+    constexpr scan_error(scan_errc code, std::string context) : code(code), context(std::move(context)) {}
+
+    constexpr std::string message() const {
+        using namespace std::string_literals;
+        const std::string type = type_name != nullptr ? type_name : "";
+        switch(code) {
+            case scan_errc::unexpected_specifier:
+                return "Unexpected result. Unexpected format specifier."s;
+            case scan_errc::wrong_specifier:
+                return "Unexpected result. Wrong or too long format specifier."s;
+            case scan_errc::mismatched_count:
+                return "Unexpected result. Mismatched number of format specifiers and target types"s;
+            case scan_errc::index_out_of_bounds:
+                return "Unexpected result. Index out of bounds during tuple population."s;
+            case scan_errc::literal_mismatch:
+                return "Unexpected result. Unformatted text in input and format string are different"s;
+            case scan_errc::unsupported_type:
+                return "Unexpected result. Type not supported for {} placeholder."s;
+            case scan_errc::string_type_mismatch:
+                return "Unexpected result. Type mismatch: 's' specifier requires a string-line type."s;
+            case scan_errc::integral_type_mismatch:
+                return "Unexpected result. Type mismatch: 'd' specifier requires an integral type."s;
+            case scan_errc::natural_type_mismatch:
+                return "Unexpected result. Type mismatch: 'u' specifier requires a natural (unsigned integer) type."s;
+            case scan_errc::floating_type_mismatch:
+                return "Unexpected result. Type mismatch: 'f' specifier requires a floating type."s;
+            case scan_errc::invalid_integer:
+                return "Unexpected result.Failed to convert to <"s + type + ">.";
+            case scan_errc::invalid_floating:
+                return "Unexpected result. Failed to convert to <"s + type + ">.";
+            case scan_errc::invalid_integer_placeholder:
+                return "Unexpected result. Failed to parse integer for {}: Failed to convert to <"s + type + ">.";
+            case scan_errc::integer_out_of_range:
+                return "Unexpected result. Integer out of range for target type {}."s;
+            case scan_errc::negative_unsigned:
+                return "Unexpected result. Negative value parsed for unsigned type {}."s;
+            case scan_errc::unsigned_out_of_range:
+                return "Unexpected result. Unsigned integer out of range for target type {}."s;
+            case scan_errc::invalid_decimal_placeholder:
+                return "Unexpected result. Failed to parse decimal for {}: Failed to convert to <"s + type + ">.";
+            case scan_errc::invalid_floating_placeholder:
+                return "Unexpected result. Failed to parse float for {}: Failed to convert to <"s + type + ">.";
+            case scan_errc::floating_out_of_range:
+                return "Unexpected result. Double value out of range for float target type {}."s;
+            case scan_errc::file_open_failed:
+                return "Unexpected result. Failed to open file: "s + context;
+            case scan_errc::file_stat_failed:
+                return "Unexpected result. Failed to stat file: "s + context;
+            case scan_errc::file_map_failed:
+                return "Unexpected result. Failed to map file: "s + context;
+            case scan_errc::stream_read_failed:
+                return "Unexpected result. Failed to read from stream."s;
+            case scan_errc::record_too_long:
+                return "Unexpected result. Record does not fit into the stream buffer."s;
+            case scan_errc::field_too_short:
+                return "Unexpected result. Input is shorter than the fixed-width field."s;
+        }
+        return "Unexpected result."s;
+    }
 };
 
 // Шаблонный класс для хранения результатов успешного сканирования.
@@ -31,4 +176,9 @@ template<typename... Ts> struct scan_result {
     std::tuple<Ts...> result {};
 };
 
+// Результат, элементы которого созданы с аллокатором ресурса resource: поля std::pmr::string размещаются в нём.
+template<typename... Ts> scan_result<Ts...> make_scan_result(std::pmr::memory_resource* resource) {
+    return scan_result<Ts...> {std::tuple<Ts...>(std::allocator_arg, std::pmr::polymorphic_allocator<> {resource})};
+}
+
 }  // namespace stdx::details
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+#include "scan.hpp"
+
+// Глобальная замена operator new, подсчитывающая выделения памяти в тестовом бинарнике.
+namespace {
+std::atomic<std::size_t> allocations_count {0};
+
+// Число выделений памяти, выполненных при вызове f.
+template<typename F> std::size_t count_allocations(F&& f) {
+    const auto before = allocations_count.load();
+    std::forward<F>(f)();
+    return allocations_count.load() - before;
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++allocations_count;
+    if(void* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// --- Allocation Tests ---
+
+TEST(AllocationTest, CounterDetectsAllocations) {
+    auto allocations = count_allocations([] {
+        auto result = stdx::scan<std::string>("a string long enough to defeat small string optimization", "{%s}");
+        ASSERT_TRUE(result);
+    });
+    EXPECT_GT(allocations, 0u);
+}
+
+TEST(AllocationTest, ScanNumericFieldsDoesNotAllocate) {
+    auto allocations = count_allocations([] {
+        auto result =
+            stdx::scan<int, unsigned int, double, float>("id=-7 n=42 x=2.5 y=0.25", "id={%d} n={%u} x={%f} y={}");
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::get<0>(result.value().result), -7);
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(AllocationTest, ScanStringViewPlaceholderDoesNotAllocate) {
+    auto allocations = count_allocations([] {
+        auto result = stdx::scan<std::string_view, int>("user=some_rather_long_user_name id=100", "user={} id={%d}");
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::get<0>(result.value().result), "some_rather_long_user_name");
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(AllocationTest, PatternScanDoesNotAllocate) {
+    auto pattern = stdx::scan_pattern<int, unsigned long long, double>::compile("[{%d}] {%u}: {%f}");
+    ASSERT_TRUE(pattern);
+    auto allocations = count_allocations([&] {
+        auto result = pattern->scan("[1] 6000000000: 3.5");
+        ASSERT_TRUE(result);
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(AllocationTest, CheckedScanDoesNotAllocate) {
+    auto allocations = count_allocations([] {
+        auto result = stdx::scan_checked<short, double>("-5; 1e10", "{%d}; {}");
+        ASSERT_TRUE(result);
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(AllocationTest, FailedScanDoesNotAllocate) {
+    auto pattern = stdx::scan_pattern<int, unsigned int>::compile("id={%d} n={%u}");
+    ASSERT_TRUE(pattern);
+    auto allocations = count_allocations([&] {
+        EXPECT_FALSE(pattern->scan("GET /index.html HTTP/1.1"));
+        EXPECT_FALSE(pattern->scan("id=x n=1"));
+        EXPECT_FALSE((stdx::scan<int, unsigned short>("id=7 n=70000", "id={} n={}")));
+        EXPECT_FALSE(stdx::scan_checked<float>("x", "{%f}"));
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(AllocationTest, StringViewSpecifierDoesNotAllocate) {
+    auto allocations = count_allocations([] {
+        auto result = stdx::scan_borrowed<std::string_view, std::string_view>(
+            "host=a-rather-long-host-name-that-defeats-sso path=/some/long/request/path", "host={%s} path={%s}");
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::get<1>(result->result), "/some/long/request/path");
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+// --- Memory Resource Tests ---
+
+TEST(AllocationTest, PmrStringFieldsUseMemoryResource) {
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    auto in_arena = [&](const std::pmr::string& s) {
+        auto* p = reinterpret_cast<const std::byte*>(s.data());
+        return p >= buffer.data() && p < buffer.data() + buffer.size();
+    };
+
+    auto allocations = count_allocations([&] {
+        auto result = stdx::scan<std::pmr::string, int, std::pmr::string>(
+            "host=a-rather-long-host-name-that-defeats-sso id=7 path=/some/long/request/path",
+            "host={%s} id={%d} path={}", &arena);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::get<0>(result->result), "a-rather-long-host-name-that-defeats-sso");
+        EXPECT_EQ(std::get<2>(result->result), "/some/long/request/path");
+        EXPECT_TRUE(in_arena(std::get<0>(result->result)));
+        EXPECT_TRUE(in_arena(std::get<2>(result->result)));
+        EXPECT_EQ(std::get<0>(result->result).get_allocator().resource(), &arena);
+    });
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(AllocationTest, CompiledFormatsUseMemoryResource) {
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    const std::string_view line = "user=some_rather_long_user_name_for_sso status=200";
+
+    auto pattern = stdx::scan_pattern<std::pmr::string, int>::compile("user={%s} status={%d}");
+    ASSERT_TRUE(pattern);
+    constexpr stdx::scan_format<std::pmr::string, int> format {"user={} status={%d}"};
+
+    auto allocations = count_allocations([&] {
+        auto compiled = stdx::scan(line, *pattern, &arena);
+        ASSERT_TRUE(compiled);
+        EXPECT_EQ(std::get<0>(compiled->result), "some_rather_long_user_name_for_sso");
+
+        auto checked = format.scan(line, &arena);
+        ASSERT_TRUE(checked);
+        EXPECT_EQ(std::get<0>(checked->result), "some_rather_long_user_name_for_sso");
+        EXPECT_EQ(std::get<1>(checked->result), 200);
+
+        EXPECT_FALSE(pattern->scan("user=x status=oops", &arena));
+    });
+    EXPECT_EQ(allocations, 0u);
+}
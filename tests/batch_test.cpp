@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "batch.hpp"
+
+// --- Columnar Batch Tests ---
+
+TEST(BatchTest, ScanIntoColumns) {
+    std::string_view buffer = "1 alpha 0.5\n2 beta 1.5\n3 gamma 2.5\n";
+    auto batch              = stdx::scan_batch<int, std::string, double>(buffer, "{%d} {%s} {%f}");
+    ASSERT_TRUE(batch.has_value());
+
+    EXPECT_EQ(batch->rows, 3u);
+    EXPECT_EQ(batch->valid_count(), 3u);
+    EXPECT_EQ(batch->column<0>(), (std::vector<int> {1, 2, 3}));
+    EXPECT_EQ(batch->column<2>(), (std::vector<double> {0.5, 1.5, 2.5}));
+
+    const auto& names = batch->column<1>();
+    ASSERT_EQ(names.size(), 3u);
+    EXPECT_EQ(buffer.substr(names[1].offset, names[1].length), "beta");
+}
+
+TEST(BatchTest, InvalidRowsAreMarkedAndAligned) {
+    std::string_view buffer = "10,20\nbroken\n30,x\n40,50";
+    auto batch              = stdx::scan_batch<int, unsigned int>(buffer, "{%d},{%u}");
+    ASSERT_TRUE(batch.has_value());
+
+    ASSERT_EQ(batch->rows, 4u);
+    EXPECT_TRUE(batch->valid(0));
+    EXPECT_FALSE(batch->valid(1));
+    EXPECT_FALSE(batch->valid(2));
+    EXPECT_TRUE(batch->valid(3));
+    EXPECT_EQ(batch->column<0>(), (std::vector<int> {10, 0, 0, 40}));
+    EXPECT_EQ(batch->column<1>(), (std::vector<unsigned int> {20, 0, 0, 50}));
+}
+
+TEST(BatchTest, ValidityBitmapSpansWords) {
+    std::string buffer;
+    for(int i = 0; i < 130; ++i) {
+        buffer += (i % 3 == 0 ? "bad" : std::to_string(i)) + "\n";
+    }
+    auto batch = stdx::scan_batch<int>(buffer, "{%d}");
+    ASSERT_TRUE(batch.has_value());
+
+    ASSERT_EQ(batch->rows, 130u);
+    EXPECT_EQ(batch->validity.size(), 3u);
+    for(std::size_t row = 0; row < batch->rows; ++row) {
+        EXPECT_EQ(batch->valid(row), row % 3 != 0);
+    }
+}
+
+TEST(BatchTest, ReuseCompiledPattern) {
+    auto pattern = stdx::scan_pattern<std::string_view, int>::compile("{}={%d}");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto batch = stdx::scan_batch("a=1\nb=2", pattern.value());
+    EXPECT_EQ(batch.rows, 2u);
+    EXPECT_EQ(batch.column<1>(), (std::vector<int> {1, 2}));
+}
+
+TEST(BatchTest, FailInvalidFormat) {
+    auto batch = stdx::scan_batch<int, int>("1 2\n", "{%d} {%s}");
+    EXPECT_FALSE(batch.has_value());
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cache.hpp"
+
+// --- Runtime Format Cache Tests ---
+
+TEST(FormatCacheTest, ScanCachedMatchesScan) {
+    std::string format = "id={%d} name={%s}";
+    auto result        = stdx::scan_cached<int, std::string>("id=7 name=alice", format);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 7);
+    EXPECT_EQ(std::get<1>(result->result), "alice");
+
+    auto failed = stdx::scan_cached<int, std::string>("id=x name=alice", format);
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error().code, stdx::details::scan_errc::invalid_integer);
+}
+
+TEST(FormatCacheTest, SameFormatReturnsSamePattern) {
+    auto& cache = stdx::format_cache<int, double>::instance();
+    auto first  = cache.get("cache-same {%d} {%f}");
+    auto second = cache.get(std::string {"cache-same {%d} {%f}"});
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->get(), second->get());
+}
+
+TEST(FormatCacheTest, SignatureIsPartOfKey) {
+    auto as_int = stdx::scan_cached<int>("42", "{}");
+    auto as_str = stdx::scan_cached<std::string>("42", "{}");
+    ASSERT_TRUE(as_int.has_value());
+    ASSERT_TRUE(as_str.has_value());
+    EXPECT_EQ(std::get<0>(as_int->result), 42);
+    EXPECT_EQ(std::get<0>(as_str->result), "42");
+}
+
+TEST(FormatCacheTest, InvalidFormatIsNotCached) {
+    auto& cache       = stdx::format_cache<short>::instance();
+    const auto before = cache.size();
+    auto result       = stdx::scan_cached<short>("1 2", "{%d} {%d}");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, stdx::details::scan_errc::mismatched_count);
+    EXPECT_EQ(cache.size(), before);
+}
+
+TEST(FormatCacheTest, LruEvictionKeepsRecentlyUsed) {
+    auto& cache = stdx::format_cache<long long>::instance();
+    cache.set_capacity(2);
+    ASSERT_TRUE(cache.get("a={%d}").has_value());
+    ASSERT_TRUE(cache.get("b={%d}").has_value());
+    EXPECT_EQ(cache.size(), 2u);
+
+    // Промах кэша потока по третьему формату вытесняет самый старый из общего кэша.
+    auto c = cache.get("c={%d}");
+    ASSERT_TRUE(c.has_value());
+    EXPECT_EQ(cache.size(), 2u);
+
+    // Вытесненный шаблон продолжает работать через кэш потока.
+    auto result = stdx::scan_cached<long long>("a=5", "a={%d}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 5);
+
+    cache.set_capacity(0);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_TRUE(stdx::scan_cached<long long>("d=1", "d={%d}").has_value());
+    EXPECT_EQ(cache.size(), 0u);
+    cache.set_capacity(stdx::format_cache<long long>::default_capacity);
+}
+
+TEST(FormatCacheTest, ConcurrentLookups) {
+    std::vector<std::thread> threads;
+    std::vector<int> sums(4, 0);
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &sums] {
+            for(int i = 0; i < 1000; ++i) {
+                const auto format = "cache-thread-" + std::to_string(i % 8) + " {%d}";
+                const auto line   = "cache-thread-" + std::to_string(i % 8) + " " + std::to_string(i);
+                if(auto result = stdx::scan_cached<unsigned short>(line, format)) {
+                    sums[t] += std::get<0>(result->result);
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    for(int sum : sums) {
+        EXPECT_EQ(sum, 999 * 1000 / 2);
+    }
+}
+
+TEST(FormatCacheTest, MemoryResourceOverload) {
+    std::pmr::monotonic_buffer_resource resource;
+    auto result = stdx::scan_cached<std::pmr::string>("name=a-string-longer-than-small-buffer", "name={%s}", &resource);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), "a-string-longer-than-small-buffer");
+    EXPECT_EQ(std::get<0>(result->result).get_allocator().resource(), &resource);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "batch.hpp"
+#include "decimal.hpp"
+#include "scan.hpp"
+
+namespace {
+
+using price = stdx::decimal<std::int64_t, 4>;
+
+template<typename T> std::from_chars_result parse(std::string_view text, T& value) {
+    return stdx::details::parse_decimal(text.data(), text.data() + text.size(), value);
+}
+
+}  // namespace
+
+// --- Floating Point And Decimal Tests ---
+
+TEST(DecimalTest, ParsesDigitsWithoutFloatingPoint) {
+    price value;
+    EXPECT_EQ(parse("123.4567", value).ec, std::errc {});
+    EXPECT_EQ(value.units, 1234567);
+    EXPECT_EQ(parse("-0.5", value).ec, std::errc {});
+    EXPECT_EQ(value.units, -5000);
+    EXPECT_EQ(parse("42", value).ec, std::errc {});
+    EXPECT_EQ(value.units, 420000);
+    EXPECT_EQ(parse(".25", value).ec, std::errc {});
+    EXPECT_EQ(value.units, 2500);
+    EXPECT_EQ(parse("7.", value).ec, std::errc {});
+    EXPECT_EQ(value.units, 70000);
+}
+
+TEST(DecimalTest, RoundsExtraFractionDigits) {
+    price value;
+    parse("0.12344999", value);
+    EXPECT_EQ(value.units, 1234);
+    parse("0.12345", value);
+    EXPECT_EQ(value.units, 1235);
+    parse("-0.00005", value);
+    EXPECT_EQ(value.units, -1);
+    parse("9.99995", value);
+    EXPECT_EQ(value.units, 100000);
+}
+
+TEST(DecimalTest, RejectsInvalidAndOutOfRange) {
+    price value {77};
+    const std::vector<std::string> invalid {"", "-", ".", "-.", "+1.0", "abc", " 1.5"};
+    for(const auto& text : invalid) {
+        auto result = parse(text, value);
+        EXPECT_EQ(result.ec, std::errc::invalid_argument) << "input: '" << text << "'";
+        EXPECT_EQ(result.ptr, text.data()) << "input: '" << text << "'";
+    }
+    EXPECT_EQ(value.units, 77);
+
+    // Максимум int64_t равен 922337203685477.5807 при Scale = 4.
+    EXPECT_EQ(parse("922337203685477.5807", value).ec, std::errc {});
+    EXPECT_EQ(value.units, INT64_MAX);
+    EXPECT_EQ(parse("-922337203685477.5808", value).ec, std::errc {});
+    EXPECT_EQ(value.units, INT64_MIN);
+    EXPECT_EQ(parse("922337203685477.5808", value).ec, std::errc::result_out_of_range);
+    EXPECT_EQ(parse("99999999999999999999999", value).ec, std::errc::result_out_of_range);
+
+    stdx::decimal<std::uint16_t, 2> small;
+    EXPECT_EQ(parse("655.35", small).ec, std::errc {});
+    EXPECT_EQ(small.units, 65535);
+    EXPECT_EQ(parse("655.36", small).ec, std::errc::result_out_of_range);
+    EXPECT_EQ(parse("-1", small).ec, std::errc::invalid_argument);
+}
+
+TEST(DecimalTest, ScanWithEmptyAndFloatingSpecifiers) {
+    auto result = stdx::scan<std::string_view, price, price>("AAPL bid=187.25 ask=187.2651", "{} bid={} ask={%f}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<1>(result->result).units, 1872500);
+    EXPECT_EQ(std::get<2>(result->result).units, 1872651);
+    EXPECT_DOUBLE_EQ(std::get<2>(result->result).to_double(), 187.2651);
+
+    auto empty = stdx::scan<price>("price=n/a", "price={}");
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().message(),
+              "Unexpected result. Failed to parse decimal for {}: Failed to convert to <decimal>.");
+
+    auto floating = stdx::scan<price>("price=n/a", "price={%f}");
+    ASSERT_FALSE(floating.has_value());
+    EXPECT_EQ(floating.error().message(), "Unexpected result. Failed to convert to <decimal>.");
+
+    auto mismatch = stdx::scan<price>("1", "{%d}");
+    EXPECT_FALSE(mismatch.has_value());
+}
+
+TEST(DecimalTest, BatchAndCompiledFormats) {
+    constexpr stdx::scan_format<price> format {"total: {%f}"};
+    auto checked = stdx::scan("total: 10.5", format);
+    ASSERT_TRUE(checked.has_value());
+    EXPECT_EQ(std::get<0>(checked->result), price {105000});
+
+    auto batch = stdx::scan_batch<int, price>("1 0.1\n2 x\n3 0.0003", "{%d} {}");
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch->column<1>(), (std::vector<price> {price {1000}, price {}, price {3}}));
+    EXPECT_EQ(batch->valid_count(), 2u);
+}
+
+TEST(DecimalTest, FloatParsedAtTargetWidth) {
+    // Прямой разбор во float даёт корректно округлённый результат.
+    auto result = stdx::scan<float, float>("0.1 3.4028235e38", "{} {%f}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 0.1f);
+    EXPECT_EQ(std::get<1>(result->result), std::numeric_limits<float>::max());
+
+    // Значения вне диапазона float и некорректный вход дают прежние ошибки.
+    auto too_large = stdx::scan<float>("1e39", "{}");
+    ASSERT_FALSE(too_large.has_value());
+    EXPECT_EQ(too_large.error().message(), "Unexpected result. Double value out of range for float target type {}.");
+
+    auto invalid = stdx::scan<float>("abc", "{}");
+    ASSERT_FALSE(invalid.has_value());
+    EXPECT_EQ(invalid.error().message(),
+              "Unexpected result. Failed to parse float for {}: Failed to convert to <double>.");
+
+    auto invalid_f = stdx::scan<float>("abc", "{%f}");
+    ASSERT_FALSE(invalid_f.has_value());
+    EXPECT_EQ(invalid_f.error().message(), "Unexpected result. Failed to convert to <double>.");
+
+    // Значение меньше наименьшего субнормального float по-прежнему округляется к нулю, а не считается ошибкой.
+    auto tiny = stdx::scan<float>("1e-50", "{}");
+    ASSERT_TRUE(tiny.has_value());
+    EXPECT_EQ(std::get<0>(tiny->result), 0.0f);
+}
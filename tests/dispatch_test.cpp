@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dispatch.hpp"
+
+// --- Multi-format Dispatcher Tests ---
+
+TEST(DispatchTest, RoutesLinesByLeadingLiteral) {
+    stdx::scan_dispatcher dispatcher;
+    std::vector<int> requests;
+    std::vector<std::string> errors;
+    double took = 0;
+    ASSERT_TRUE(dispatcher.add<int>("GET id={%d}", [&](int id) { requests.push_back(id); }).has_value());
+    ASSERT_TRUE(dispatcher.add<std::string>("ERROR {%s}", [&](std::string text) { errors.push_back(text); }));
+    ASSERT_TRUE(dispatcher.add<double>("took {%f} ms", [&](double value) { took = value; }));
+    EXPECT_EQ(dispatcher.size(), 3u);
+
+    EXPECT_EQ(dispatcher.dispatch("GET id=42"), 0u);
+    EXPECT_EQ(dispatcher.dispatch("ERROR disk full"), 1u);
+    EXPECT_EQ(dispatcher.dispatch("took 1.5 ms"), 2u);
+    EXPECT_EQ(dispatcher.dispatch("GET id=7"), 0u);
+
+    EXPECT_EQ(requests, (std::vector<int> {42, 7}));
+    EXPECT_EQ(errors, (std::vector<std::string> {"disk full"}));
+    EXPECT_DOUBLE_EQ(took, 1.5);
+}
+
+TEST(DispatchTest, UnmatchedLine) {
+    stdx::scan_dispatcher dispatcher;
+    ASSERT_TRUE(dispatcher.add<int>("GET id={%d}", [](int) {}));
+    EXPECT_EQ(dispatcher.dispatch("POST id=1"), stdx::scan_dispatcher::npos);
+    EXPECT_EQ(dispatcher.dispatch(""), stdx::scan_dispatcher::npos);
+    EXPECT_EQ(dispatcher.dispatch("GET id=abc"), stdx::scan_dispatcher::npos);
+}
+
+TEST(DispatchTest, LeadingLiteralIsAnchored) {
+    stdx::scan_dispatcher dispatcher;
+    ASSERT_TRUE(dispatcher.add<int>("id={%d}", [](int) {}));
+    EXPECT_EQ(dispatcher.dispatch("id=5"), 0u);
+    // scan нашёл бы литерал и в середине строки, а диспетчер требует его в начале.
+    EXPECT_EQ(dispatcher.dispatch("x id=5"), stdx::scan_dispatcher::npos);
+}
+
+TEST(DispatchTest, LongerPrefixIsTriedFirst) {
+    stdx::scan_dispatcher dispatcher;
+    std::string order;
+    ASSERT_TRUE(dispatcher.add<std::string_view>("[{%s}]", [&](std::string_view) { order += 'a'; }));
+    ASSERT_TRUE(dispatcher.add<int>("[ERROR] code={%d}", [&](int) { order += 'b'; }));
+
+    EXPECT_EQ(dispatcher.dispatch("[ERROR] code=3"), 1u);
+    // Более длинный префикс совпал, но формат не разобрал строку: пробуется более короткий.
+    EXPECT_EQ(dispatcher.dispatch("[ERROR] code=x]"), 0u);
+    EXPECT_EQ(dispatcher.dispatch("[INFO]"), 0u);
+    EXPECT_EQ(order, "baa");
+}
+
+TEST(DispatchTest, SamePrefixInInsertionOrder) {
+    stdx::scan_dispatcher dispatcher;
+    int integers = 0;
+    int words    = 0;
+    ASSERT_TRUE(dispatcher.add<int>("value={%d}", [&](int) { ++integers; }));
+    ASSERT_TRUE(dispatcher.add<std::string_view>("value={%s}", [&](std::string_view) { ++words; }));
+
+    EXPECT_EQ(dispatcher.dispatch("value=12"), 0u);
+    EXPECT_EQ(dispatcher.dispatch("value=twelve"), 1u);
+    EXPECT_EQ(integers, 1);
+    EXPECT_EQ(words, 1);
+}
+
+TEST(DispatchTest, FormatWithoutLeadingLiteralIsFallback) {
+    stdx::scan_dispatcher dispatcher;
+    ASSERT_TRUE(dispatcher.add<std::string_view>("{%s}", [](std::string_view) {}));
+    ASSERT_TRUE(dispatcher.add<int>("n={%d}", [](int) {}));
+
+    EXPECT_EQ(dispatcher.dispatch("n=1"), 1u);
+    EXPECT_EQ(dispatcher.dispatch("n=?"), 0u);
+    EXPECT_EQ(dispatcher.dispatch("anything"), 0u);
+}
+
+TEST(DispatchTest, MultipleFieldsAreHandlerArguments) {
+    stdx::scan_dispatcher dispatcher;
+    int id = 0;
+    std::string name;
+    auto added = dispatcher.add<int, std::string>("user {%d}: {%s}", [&](int i, std::string n) {
+        id   = i;
+        name = std::move(n);
+    });
+    ASSERT_TRUE(added.has_value());
+    EXPECT_EQ(dispatcher.dispatch("user 17: alice"), 0u);
+    EXPECT_EQ(id, 17);
+    EXPECT_EQ(name, "alice");
+}
+
+TEST(DispatchTest, InvalidFormatIsRejected) {
+    stdx::scan_dispatcher dispatcher;
+    auto added = dispatcher.add<int>("{%d} {%d}", [](int) {});
+    ASSERT_FALSE(added.has_value());
+    EXPECT_EQ(added.error().code, stdx::details::scan_errc::mismatched_count);
+    EXPECT_EQ(dispatcher.size(), 0u);
+
+    auto mismatched = dispatcher.add<int>("{%s}", [](int) {});
+    ASSERT_FALSE(mismatched.has_value());
+    EXPECT_EQ(mismatched.error().code, stdx::details::scan_errc::string_type_mismatch);
+}
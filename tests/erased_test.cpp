@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "erased.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// scan_compact и scan дают одинаковый ответ: значения при успехе, код, поле и смещение при ошибке.
+template<typename... Ts> void expect_same_as_scan(std::string_view input, std::string_view format) {
+    auto compact = stdx::scan_compact<Ts...>(input, format);
+    auto scanned = stdx::scan<Ts...>(input, format);
+    ASSERT_EQ(compact.has_value(), scanned.has_value()) << input;
+    if(compact) {
+        EXPECT_EQ(compact->result, scanned->result) << input;
+    }
+    else {
+        EXPECT_EQ(compact.error().code, scanned.error().code) << input;
+        EXPECT_EQ(compact.error().field, scanned.error().field) << input;
+        EXPECT_EQ(compact.error().offset, scanned.error().offset) << input;
+        EXPECT_EQ(compact.error().message(), scanned.error().message()) << input;
+    }
+}
+
+}  // namespace
+
+#if STDX_SCAN_ERASED
+// Сборка с компактным бэкендом получает свои имена типов, как и сборка со статистикой.
+static_assert(std::is_same_v<stdx::scan_pattern<int>, stdx::stats_off_erased::scan_pattern<int>>);
+#endif
+
+// --- Type-Erased Backend Tests ---
+
+TEST(ErasedTest, SupportedSignatures) {
+    static_assert(stdx::details::is_erasable<int, double, std::string, std::string_view, stdx::skip>);
+    static_assert(stdx::details::is_erasable<signed char, unsigned long long int, const char*, std::pmr::string>);
+    static_assert(!stdx::details::is_erasable<int, long int>);
+    static_assert(!stdx::details::is_erasable<bool>);
+}
+
+TEST(ErasedTest, ValuesOfAllTypes) {
+    auto result = stdx::scan_compact<signed char, unsigned short int, long long int, float, std::string,
+                                     std::string_view, stdx::skip>("-5 65535 -9000000000 2.5 name view ?",
+                                                                   "{%d} {%u} {%d} {%f} {%s} {} {*}");
+    ASSERT_TRUE(result.has_value()) << result.error().message();
+    EXPECT_EQ(std::get<0>(result->result), -5);
+    EXPECT_EQ(std::get<1>(result->result), 65535);
+    EXPECT_EQ(std::get<2>(result->result), -9'000'000'000);
+    EXPECT_FLOAT_EQ(std::get<3>(result->result), 2.5f);
+    EXPECT_EQ(std::get<4>(result->result), "name");
+    EXPECT_EQ(std::get<5>(result->result), "view");
+}
+
+TEST(ErasedTest, AgreesWithScan) {
+    expect_same_as_scan<int, double>("a=1 b=2.5", "a={%d} b={%f}");
+    expect_same_as_scan<int, int>("a=1 b=x2", "a={%d} b={%d}");
+    expect_same_as_scan<int, int>("a=1 b=2", "a={%d}, b={%d}");
+    expect_same_as_scan<std::string_view, signed char>("key: 300", "{}: {}");
+    expect_same_as_scan<unsigned int>("-1", "{%u}");
+    expect_same_as_scan<int>("1", "{%x}");
+    expect_same_as_scan<int, int>("1 2", "{%d} {%d} {%d}");
+    expect_same_as_scan<int, std::string>("42", "{%s}{%d}");
+    expect_same_as_scan<int, stdx::skip, double>("7 not-a-number 2.5", "{%d} {*} {%f}");
+    expect_same_as_scan<int, unsigned int>("0042 17", "{%4d} {%u}");
+    expect_same_as_scan<int>("", "{%d}");
+}
+
+TEST(ErasedTest, PmrStringsUseResource) {
+    char storage[256];
+    std::pmr::monotonic_buffer_resource resource {storage, sizeof(storage), std::pmr::null_memory_resource()};
+    const std::string long_name(40, 'n');
+    auto result = stdx::scan_compact<std::pmr::string, int>(long_name + " 7", "{%s} {%d}", &resource);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), std::string_view {long_name});
+    EXPECT_EQ(std::get<0>(result->result).get_allocator().resource(), &resource);
+    EXPECT_EQ(std::get<1>(result->result), 7);
+}
+
+TEST(ErasedTest, ScanRoutesThroughCompactBackend) {
+    // В сборке с STDX_SCAN_ERASED=1 scan идёт через таблицу конвертеров; ответ от этого не меняется.
+    auto result = stdx::scan<int, std::string_view>("12 abc", "{%d} {%s}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 12);
+    EXPECT_EQ(std::get<1>(result->result), "abc");
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <vector>
+
+#include "file.hpp"
+
+namespace {
+
+// Временный файл с заданным содержимым, удаляемый по завершении теста.
+struct temp_file {
+    explicit temp_file(std::string_view content) :
+        path(std::filesystem::temp_directory_path() /
+             ("scan_file_test_" + std::to_string(::getpid()) + "_" + std::to_string(counter++) + ".txt")) {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    ~temp_file() {
+        std::filesystem::remove(path);
+    }
+
+    static inline int counter = 0;
+    std::filesystem::path path;
+};
+
+}  // namespace
+
+static_assert(std::ranges::input_range<stdx::file_scan<int>>);
+
+// --- Memory-mapped File Tests ---
+
+TEST(FileScanTest, ScanEveryLine) {
+    temp_file file {"1 alpha\n2 beta\n3 gamma\n"};
+    auto lines = stdx::scan_file<int, std::string>(file.path, "{%d} {%s}");
+    ASSERT_TRUE(lines.has_value());
+
+    std::vector<int> ids;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        ids.push_back(std::get<0>(line->result));
+    }
+    EXPECT_EQ(ids, (std::vector<int> {1, 2, 3}));
+}
+
+TEST(FileScanTest, LastLineWithoutNewline) {
+    temp_file file {"10\n20\n30"};
+    auto lines = stdx::scan_file<int>(file.path, "{%d}");
+    ASSERT_TRUE(lines.has_value());
+
+    std::vector<int> values;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        values.push_back(std::get<0>(line->result));
+    }
+    EXPECT_EQ(values, (std::vector<int> {10, 20, 30}));
+}
+
+TEST(FileScanTest, StringViewFieldsPointIntoMapping) {
+    temp_file file {"user=alice\nuser=bob\n"};
+    auto lines = stdx::scan_file<std::string_view>(file.path, "user={}");
+    ASSERT_TRUE(lines.has_value());
+
+    auto source = lines->source();
+    std::vector<std::string_view> users;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        auto user = std::get<0>(line->result);
+        EXPECT_GE(user.data(), source.data());
+        EXPECT_LE(user.data() + user.size(), source.data() + source.size());
+        users.push_back(user);
+    }
+    EXPECT_EQ(users, (std::vector<std::string_view> {"alice", "bob"}));
+}
+
+TEST(FileScanTest, FailedLinesAreReported) {
+    temp_file file {"1\nnot a number\n3\n"};
+    auto lines = stdx::scan_file<int>(file.path, "{%d}");
+    ASSERT_TRUE(lines.has_value());
+
+    std::vector<bool> matched;
+    for(const auto& line : lines.value()) {
+        matched.push_back(line.has_value());
+    }
+    EXPECT_EQ(matched, (std::vector<bool> {true, false, true}));
+}
+
+TEST(FileScanTest, EmptyFileHasNoLines) {
+    temp_file file {""};
+    auto lines = stdx::scan_file<int>(file.path, "{%d}");
+    ASSERT_TRUE(lines.has_value());
+    EXPECT_TRUE(lines->begin() == lines->end());
+}
+
+TEST(FileScanTest, FailMissingFile) {
+    auto lines = stdx::scan_file<int>("/nonexistent/scan_file_test.txt", "{%d}");
+    ASSERT_FALSE(lines.has_value());
+    EXPECT_NE(lines.error().message().find("Failed to open file"), std::string::npos);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "batch.hpp"
+#include "match.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Позиционная запись: 8 байт счёта, 12 байт имени, 10 байт суммы, без разделителей.
+constexpr std::string_view record_format = "{%8d}{%12s}{%10f}";
+constexpr std::string_view record_line   = "00001234ACME CORP      1050.25";
+
+}  // namespace
+
+// --- Fixed-Width Field Tests ---
+
+TEST(FixedWidthTest, ScanPositionalRecord) {
+    auto result = stdx::scan<int, std::string, double>(record_line, record_format);
+    ASSERT_TRUE(result.has_value());
+    auto [account, name, amount] = result->result;
+    EXPECT_EQ(account, 1234);
+    EXPECT_EQ(name, "ACME CORP");
+    EXPECT_DOUBLE_EQ(amount, 1050.25);
+}
+
+TEST(FixedWidthTest, PatternComputesOffsets) {
+    auto pattern = stdx::scan_pattern<int, std::string_view, double>::compile(record_format);
+    ASSERT_TRUE(pattern.has_value());
+
+    std::array<std::string_view, 3> fields;
+    ASSERT_TRUE(pattern->match(record_line, fields).has_value());
+    EXPECT_EQ(fields[0], "00001234");
+    EXPECT_EQ(fields[1], "ACME CORP");
+    EXPECT_EQ(fields[2], "1050.25");
+    EXPECT_EQ(fields[2].data(), record_line.data() + 23);
+}
+
+TEST(FixedWidthTest, CheckedFormat) {
+    auto result = stdx::scan_checked<unsigned int, std::string_view, double>(record_line, "{%8u}{%12s}{%10f}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 1234u);
+    EXPECT_EQ(std::get<1>(result->result), "ACME CORP");
+}
+
+TEST(FixedWidthTest, LiteralsAreComparedInPlace) {
+    auto result = stdx::scan<int, int>("R| 42|  7|", "R|{%3d}|{%3d}|");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 42);
+    EXPECT_EQ(std::get<1>(result->result), 7);
+
+    // Литерал не на своём месте не ищется дальше по строке.
+    auto shifted = stdx::scan<int, int>("R|  42|  7|", "R|{%3d}|{%3d}|");
+    ASSERT_FALSE(shifted.has_value());
+    EXPECT_EQ(shifted.error().code, stdx::details::scan_errc::literal_mismatch);
+}
+
+TEST(FixedWidthTest, PositionalPrefixIsAnchored) {
+    auto pattern = stdx::scan_pattern<int>::compile("ID{%4d}");
+    ASSERT_TRUE(pattern.has_value());
+    EXPECT_TRUE(pattern->scan("ID0042").has_value());
+
+    auto result = pattern->scan("xID0042");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, stdx::details::scan_errc::literal_mismatch);
+    EXPECT_EQ(result.error().field, 0u);
+}
+
+TEST(FixedWidthTest, PositionalPrefixIsAnchoredEverywhere) {
+    // Runtime-формат, скомпилированный шаблон, проверенный формат и проверка без конверсии разбирают позиционную
+    // запись по одним правилам.
+    for(std::string_view line : {"ID0001", "xxID0001"}) {
+        const bool anchored = line.starts_with("ID");
+        auto scanned        = stdx::scan<int>(line, "ID{%4d}");
+        auto compiled       = stdx::scan_pattern<int>::compile("ID{%4d}").value().scan(line);
+        auto checked        = stdx::scan_checked<int>(line, "ID{%4d}");
+        EXPECT_EQ(scanned.has_value(), anchored) << line;
+        EXPECT_EQ(compiled.has_value(), anchored) << line;
+        EXPECT_EQ(checked.has_value(), anchored) << line;
+        EXPECT_EQ(stdx::matches(line, "ID{%4d}").value(), anchored) << line;
+        if(!anchored) {
+            EXPECT_EQ(scanned.error().code, stdx::details::scan_errc::literal_mismatch);
+            EXPECT_EQ(scanned.error().field, compiled.error().field);
+            EXPECT_EQ(scanned.error().offset, compiled.error().offset);
+        }
+    }
+}
+
+TEST(FixedWidthTest, MixedWithDelimitedFields) {
+    auto result = stdx::scan<std::string, int, std::string>("user=alice code=  17 rest of line",
+                                                            "user={%s} code={%4d} {}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), "alice");
+    EXPECT_EQ(std::get<1>(result->result), 17);
+    EXPECT_EQ(std::get<2>(result->result), "rest of line");
+}
+
+TEST(FixedWidthTest, FailShortInput) {
+    auto result = stdx::scan<int, std::string, double>("00001234ACME", record_format);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, stdx::details::scan_errc::field_too_short);
+    EXPECT_EQ(result.error().field, 1u);
+    EXPECT_EQ(result.error().offset, 8u);
+
+    auto pattern = stdx::scan_pattern<int, std::string, double>::compile(record_format);
+    ASSERT_TRUE(pattern.has_value());
+    auto compiled = pattern->scan("00001234ACME");
+    ASSERT_FALSE(compiled.has_value());
+    EXPECT_EQ(compiled.error().code, stdx::details::scan_errc::field_too_short);
+    EXPECT_EQ(compiled.error().field, 1u);
+    EXPECT_EQ(compiled.error().offset, 8u);
+}
+
+TEST(FixedWidthTest, FailInvalidValueInSlice) {
+    auto result = stdx::scan<int, std::string, double>("x0001234ACME CORP      1050.25", record_format);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, stdx::details::scan_errc::invalid_integer);
+    EXPECT_EQ(result.error().field, 0u);
+}
+
+TEST(FixedWidthTest, FailInvalidWidth) {
+    auto zero = stdx::scan<int>("1", "{%0d}");
+    ASSERT_FALSE(zero.has_value());
+    EXPECT_EQ(zero.error().code, stdx::details::scan_errc::wrong_specifier);
+
+    auto letters = stdx::scan_pattern<int>::compile("{%1x2d}");
+    ASSERT_FALSE(letters.has_value());
+    EXPECT_EQ(letters.error().code, stdx::details::scan_errc::wrong_specifier);
+
+    auto unknown = stdx::scan_pattern<int>::compile("{%8x}");
+    ASSERT_FALSE(unknown.has_value());
+    EXPECT_EQ(unknown.error().code, stdx::details::scan_errc::unexpected_specifier);
+}
+
+TEST(FixedWidthTest, AdjacentDelimitedPlaceholdersStillFail) {
+    auto pattern = stdx::scan_pattern<int, int>::compile("{%d}{%4d}");
+    ASSERT_FALSE(pattern.has_value());
+    EXPECT_EQ(pattern.error().code, stdx::details::scan_errc::index_out_of_bounds);
+}
+
+TEST(FixedWidthTest, BatchOfRecords) {
+    std::string_view buffer = "0001   1.5\n0002  -2.0\nbad!   0.0\n0004  10.0\n";
+    auto batch              = stdx::scan_batch<int, double>(buffer, "{%4d}{%6f}");
+    ASSERT_TRUE(batch.has_value());
+
+    ASSERT_EQ(batch->rows, 4u);
+    EXPECT_FALSE(batch->valid(2));
+    EXPECT_EQ(batch->column<0>(), (std::vector<int> {1, 2, 0, 4}));
+    EXPECT_EQ(batch->column<1>(), (std::vector<double> {1.5, -2.0, 0.0, 10.0}));
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <charconv>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "integer.hpp"
+#include "scan.hpp"
+
+namespace {
+
+// Сравнение parse_integer с std::from_chars на одной строке: совпадать должны позиция, код ошибки и значение.
+template<typename T> void expect_same_as_from_chars(const std::string& text) {
+    const char* first = text.data();
+    const char* last  = text.data() + text.size();
+
+    T expected_value = 42;
+    T actual_value   = 42;
+    auto expected    = std::from_chars(first, last, expected_value);
+    auto actual      = stdx::details::parse_integer(first, last, actual_value);
+
+    EXPECT_EQ(actual.ptr, expected.ptr) << "input: '" << text << "'";
+    EXPECT_EQ(actual.ec, expected.ec) << "input: '" << text << "'";
+    EXPECT_EQ(actual_value, expected_value) << "input: '" << text << "'";
+}
+
+// Случайная строка из цифр, знаков и мусора: длина до 24 символов, чтобы попадать и в SWAR-блоки, и в переполнение.
+std::string random_number(std::mt19937& rng) {
+    static constexpr std::string_view digits = "0123456789";
+    std::string text;
+    switch(rng() % 4) {
+    case 0: text += '-'; break;
+    case 1: text += '+'; break;
+    default: break;
+    }
+    const auto length = rng() % 25;
+    for(std::size_t i = 0; i < length; ++i) {
+        text += digits[rng() % digits.size()];
+    }
+    if(rng() % 3 == 0) {
+        text += "x1/:9"[rng() % 5];
+        text += std::to_string(rng() % 1000);
+    }
+    return text;
+}
+
+template<typename T> void check_random_inputs(unsigned seed) {
+    std::mt19937 rng {seed};
+    for(int iteration = 0; iteration < 20000; ++iteration) {
+        expect_same_as_from_chars<T>(random_number(rng));
+    }
+}
+
+template<typename T> void check_boundaries() {
+    const auto min = std::to_string(std::numeric_limits<T>::min());
+    const auto max = std::to_string(std::numeric_limits<T>::max());
+    for(const auto& text : std::vector<std::string> {min, max, max + "0", "-" + max + "0", "0", "-0", "", "-", "+1",
+                                                     "0000000000000000000001", "99999999999999999999999",
+                                                     "18446744073709551616", "-9223372036854775809", " 1", "12ab"}) {
+        expect_same_as_from_chars<T>(text);
+    }
+    // Значения на единицу за границами диапазона.
+    if constexpr(sizeof(T) < sizeof(long long)) {
+        expect_same_as_from_chars<T>(std::to_string(static_cast<long long>(std::numeric_limits<T>::max()) + 1));
+        expect_same_as_from_chars<T>(std::to_string(static_cast<long long>(std::numeric_limits<T>::min()) - 1));
+    }
+}
+
+}  // namespace
+
+// --- SWAR Integer Parsing Tests ---
+
+TEST(IntegerTest, LeadingDigitsCountsDigitBytes) {
+    using stdx::details::leading_digits;
+    using stdx::details::load_eight_chars;
+    EXPECT_EQ(leading_digits(load_eight_chars("12345678")), 8u);
+    EXPECT_EQ(leading_digits(load_eight_chars("1234567a")), 7u);
+    EXPECT_EQ(leading_digits(load_eight_chars("123:5678")), 3u);
+    EXPECT_EQ(leading_digits(load_eight_chars("/2345678")), 0u);
+    EXPECT_EQ(leading_digits(load_eight_chars("9\xff\xff\xff\xff\xff\xff\xff")), 1u);
+    EXPECT_EQ(stdx::details::eight_digits_value(load_eight_chars("12345678")), 12345678u);
+    EXPECT_EQ(stdx::details::eight_digits_value(load_eight_chars("00000009")), 9u);
+}
+
+TEST(IntegerTest, RandomInputsMatchFromChars) {
+    check_random_inputs<signed char>(1);
+    check_random_inputs<unsigned char>(2);
+    check_random_inputs<short>(3);
+    check_random_inputs<unsigned short>(4);
+    check_random_inputs<int>(5);
+    check_random_inputs<unsigned int>(6);
+    check_random_inputs<long>(7);
+    check_random_inputs<long long>(8);
+    check_random_inputs<unsigned long long>(9);
+}
+
+TEST(IntegerTest, BoundariesMatchFromChars) {
+    check_boundaries<signed char>();
+    check_boundaries<unsigned char>();
+    check_boundaries<short>();
+    check_boundaries<unsigned short>();
+    check_boundaries<int>();
+    check_boundaries<unsigned int>();
+    check_boundaries<long long>();
+    check_boundaries<unsigned long long>();
+}
+
+TEST(IntegerTest, ParsesAtCompileTime) {
+    static_assert([] {
+        int value = 0;
+        auto [ptr, ec] = stdx::details::parse_integer("-123456789012", "-123456789012" + 13, value);
+        return ec == std::errc::result_out_of_range;
+    }());
+    static_assert([] {
+        long long value = 0;
+        stdx::details::parse_integer("-1234567890123", "-1234567890123" + 14, value);
+        return value == -1234567890123;
+    }());
+}
+
+TEST(IntegerTest, ScanKeepsRangeErrors) {
+    auto narrow = stdx::scan<unsigned char>("300", "{}");
+    ASSERT_FALSE(narrow.has_value());
+    EXPECT_EQ(narrow.error().message(), "Unexpected result. Unsigned integer out of range for target type {}.");
+
+    auto negative = stdx::scan<unsigned int>("-5", "{}");
+    ASSERT_FALSE(negative.has_value());
+    EXPECT_EQ(negative.error().message(), "Unexpected result. Negative value parsed for unsigned type {}.");
+
+    auto wide = stdx::scan<int>("123456789012", "{%d}");
+    EXPECT_FALSE(wide.has_value());
+
+    auto value = stdx::scan<unsigned long long, int>("18446744073709551615 -2147483648", "{%u} {%d}");
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(std::get<0>(value->result), std::numeric_limits<unsigned long long>::max());
+    EXPECT_EQ(std::get<1>(value->result), std::numeric_limits<int>::min());
+}
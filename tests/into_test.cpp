@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "into.hpp"
+
+namespace {
+
+struct request {
+    unsigned timestamp;
+    std::string method;
+    int id;
+    double took;
+};
+
+struct with_decimal {
+    std::string_view symbol;
+    stdx::decimal<long long, 2> price;
+};
+
+// Агрегаты, которые scan_into отвергает: brace elision раскладывает массив на элементы, и без проверки он
+// считался бы несколькими членами.
+struct with_array {
+    int values[2];
+    int id;
+};
+
+struct with_single_element_array {
+    int values[1];
+    int id;
+};
+
+struct point {
+    int x;
+    int y;
+};
+
+struct with_nested {
+    point position;
+    int id;
+};
+
+struct sixteen {
+    int m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16;
+};
+
+struct seventeen {
+    int m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17;
+};
+
+template<typename T>
+constexpr bool members_are_direct = stdx::details::members_are_direct<T, stdx::details::aggregate_arity<T>()>();
+
+template<typename T>
+using tied_members = decltype(stdx::details::tie_exactly<stdx::details::aggregate_arity<T>()>(std::declval<T&>()));
+
+}  // namespace
+
+static_assert(stdx::details::aggregate_arity<request>() == 4);
+static_assert(stdx::details::aggregate_arity<with_decimal>() == 2);
+static_assert(!stdx::details::is_scan_aggregate<stdx::decimal<int, 2>>);
+static_assert(!stdx::details::is_scan_aggregate<std::string>);
+
+static_assert(members_are_direct<request>);
+static_assert(members_are_direct<with_decimal>);
+static_assert(stdx::details::aggregate_arity<with_array>() == 3);
+static_assert(!members_are_direct<with_array>);
+static_assert(members_are_direct<with_single_element_array>);
+static_assert(stdx::details::has_nested_members<tied_members<with_single_element_array>>);
+static_assert(stdx::details::aggregate_arity<with_nested>() == 2);
+static_assert(stdx::details::has_nested_members<tied_members<with_nested>>);
+static_assert(!stdx::details::has_nested_members<tied_members<request>>);
+static_assert(stdx::details::aggregate_arity<sixteen>() == 16);
+static_assert(stdx::details::aggregate_arity<seventeen>() > stdx::details::max_aggregate_members);
+
+// --- In-place Scan Tests ---
+
+TEST(ScanIntoTest, IntoReferences) {
+    int id = 0;
+    std::string name;
+    double ratio = 0;
+    auto result  = stdx::scan_into("id=7 name=alice ratio=0.5", "id={%d} name={%s} ratio={%f}", id, name, ratio);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(id, 7);
+    EXPECT_EQ(name, "alice");
+    EXPECT_DOUBLE_EQ(ratio, 0.5);
+}
+
+TEST(ScanIntoTest, ReusesStringCapacity) {
+    std::string name;
+    name.reserve(64);
+    const auto* buffer = name.data();
+    for(std::string_view line : {"user=a-rather-long-user-name-one", "user=another-long-user-name-two", "user=x"}) {
+        ASSERT_TRUE(stdx::scan_into(line, "user={%s}", name).has_value());
+        EXPECT_EQ(name, line.substr(5));
+        EXPECT_EQ(name.data(), buffer);
+    }
+}
+
+TEST(ScanIntoTest, IntoAggregateMembers) {
+    request out {};
+    auto result = stdx::scan_into("[1700000000] GET id=42 took 12.25 ms", "[{%u}] {%s} id={%d} took {%f} ms", out);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(out.timestamp, 1700000000u);
+    EXPECT_EQ(out.method, "GET");
+    EXPECT_EQ(out.id, 42);
+    EXPECT_DOUBLE_EQ(out.took, 12.25);
+
+    with_decimal quote {};
+    ASSERT_TRUE(stdx::scan_into("AAPL 187.26", "{%s} {%f}", quote).has_value());
+    EXPECT_EQ(quote.symbol, "AAPL");
+    EXPECT_EQ(quote.price.units, 18726);
+}
+
+TEST(ScanIntoTest, SixteenMembers) {
+    sixteen out {};
+    ASSERT_TRUE(stdx::scan_into("1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16",
+                                "{} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {}", out));
+    EXPECT_EQ(out.m1, 1);
+    EXPECT_EQ(out.m16, 16);
+}
+
+TEST(ScanIntoTest, CompiledPattern) {
+    auto pattern = stdx::scan_pattern<unsigned, std::string, int, double>::compile("[{%u}] {%s} id={%d} took {%f} ms");
+    ASSERT_TRUE(pattern.has_value());
+
+    request out {};
+    ASSERT_TRUE(stdx::scan_into("[1] POST id=3 took 0.5 ms", pattern.value(), out).has_value());
+    EXPECT_EQ(out.method, "POST");
+    EXPECT_EQ(out.id, 3);
+
+    unsigned timestamp = 0;
+    std::string method;
+    int id      = 0;
+    double took = 0;
+    ASSERT_TRUE(stdx::scan_into("[2] PUT id=4 took 1.5 ms", pattern.value(), timestamp, method, id, took));
+    EXPECT_EQ(timestamp, 2u);
+    EXPECT_EQ(method, "PUT");
+}
+
+TEST(ScanIntoTest, ErrorsMatchScan) {
+    int id   = 5;
+    int code = 9;
+    auto literal = stdx::scan_into("a=1;b=2", "a={%d},b={%d}", id, code);
+    ASSERT_FALSE(literal.has_value());
+    EXPECT_EQ(literal.error().code, stdx::details::scan_errc::literal_mismatch);
+    EXPECT_EQ(id, 5);
+
+    // Поля до ошибочного записаны, а после него не изменены.
+    auto conversion = stdx::scan_into("a=1,b=x", "a={%d},b={%d}", id, code);
+    ASSERT_FALSE(conversion.has_value());
+    EXPECT_EQ(conversion.error().code, stdx::details::scan_errc::invalid_integer);
+    EXPECT_EQ(conversion.error().field, 1u);
+    EXPECT_EQ(conversion.error().offset, 6u);
+    EXPECT_EQ(id, 1);
+    EXPECT_EQ(code, 9);
+
+    double value = 0;
+    auto type    = stdx::scan_into("1", "{%d}", value);
+    ASSERT_FALSE(type.has_value());
+    EXPECT_EQ(type.error().code, stdx::details::scan_errc::integral_type_mismatch);
+
+    auto count = stdx::scan_into("1 2", "{%d} {%d}", id);
+    ASSERT_FALSE(count.has_value());
+    EXPECT_EQ(count.error().code, stdx::details::scan_errc::mismatched_count);
+}
+
+TEST(ScanIntoTest, SkipPlaceholderLeavesTargetUntouched) {
+    int id            = 0;
+    std::string other = "kept";
+    ASSERT_TRUE(stdx::scan_into("12 replaced", "{%d} {*}", id, other).has_value());
+    EXPECT_EQ(id, 12);
+    EXPECT_EQ(other, "kept");
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "lazy.hpp"
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view wide_format = "{%u} {} {%s} {%d} {%f} {*} {%f}";
+constexpr std::string_view wide_line   = "1700000000 host-7 GET 200 0.031 ignored 12.5";
+
+using wide_record = stdx::lazy_record<unsigned, std::string, std::string_view, int, double, stdx::skip, double>;
+
+}  // namespace
+
+// --- Lazy Record Tests ---
+
+TEST(LazyScanTest, FieldsAreConvertedOnDemand) {
+    auto record = stdx::scan_lazy<unsigned, std::string, std::string_view, int, double, stdx::skip, double>(
+        wide_line, wide_format);
+    ASSERT_TRUE(record.has_value());
+    static_assert(std::same_as<std::remove_cvref_t<decltype(*record)>, wide_record>);
+
+    EXPECT_FALSE(record->converted<3>());
+    const auto& status = record->get<3>();
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(status.value(), 200);
+    EXPECT_TRUE(record->converted<3>());
+
+    // Повторное обращение возвращает запомненное значение.
+    EXPECT_EQ(&record->get<3>(), &status);
+
+    // Остальные поля не конвертировались.
+    EXPECT_FALSE(record->converted<0>());
+    EXPECT_FALSE(record->converted<4>());
+    EXPECT_FALSE(record->converted<6>());
+
+    EXPECT_EQ(record->get<1>().value(), "host-7");
+    EXPECT_DOUBLE_EQ(record->get<6>().value(), 12.5);
+    EXPECT_EQ(record->field(5), "ignored");
+    EXPECT_EQ(record->source(), wide_line);
+}
+
+TEST(LazyScanTest, StructuralMismatchFailsImmediately) {
+    auto record = stdx::scan_lazy<int, int>("1-2", "{%d},{%d}");
+    ASSERT_FALSE(record.has_value());
+    EXPECT_EQ(record.error().code, stdx::details::scan_errc::literal_mismatch);
+}
+
+TEST(LazyScanTest, ConversionErrorIsReportedOnAccess) {
+    constexpr std::string_view line = "id=abc took 1.5";
+    auto record                     = stdx::scan_lazy<int, double>(line, "id={%d} took {%f}");
+    ASSERT_TRUE(record.has_value());
+
+    EXPECT_DOUBLE_EQ(record->get<1>().value(), 1.5);
+    const auto& id = record->get<0>();
+    ASSERT_FALSE(id.has_value());
+    EXPECT_EQ(id.error().code, stdx::details::scan_errc::invalid_integer);
+    EXPECT_EQ(id.error().field, 0u);
+    EXPECT_EQ(id.error().offset, 3u);
+    auto eager = stdx::scan<int, double>(line, "id={%d} took {%f}");
+    ASSERT_FALSE(eager.has_value());
+    EXPECT_EQ(id.error().message(), eager.error().message());
+}
+
+TEST(LazyScanTest, FormatErrorsMatchScan) {
+    auto count = stdx::scan_lazy<int>("1 2", "{%d} {%d}");
+    ASSERT_FALSE(count.has_value());
+    EXPECT_EQ(count.error().code, stdx::details::scan_errc::mismatched_count);
+
+    auto type = stdx::scan_lazy<double>("1", "{%d}");
+    ASSERT_FALSE(type.has_value());
+    EXPECT_EQ(type.error().message(), stdx::scan<double>("1", "{%d}").error().message());
+}
+
+TEST(LazyScanTest, CompiledPattern) {
+    using pattern_type = stdx::scan_pattern<unsigned, std::string, std::string_view, int, double, stdx::skip, double>;
+    auto pattern       = pattern_type::compile(wide_format);
+    ASSERT_TRUE(pattern.has_value());
+    auto record = stdx::scan_lazy(wide_line, pattern.value());
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->get<2>().value(), "GET");
+    EXPECT_EQ(record->get<0>().value(), 1700000000u);
+    EXPECT_FALSE(record->converted<1>());
+}
+
+template<typename Input>
+concept can_scan_lazy_from = requires(Input&& input) { stdx::scan_lazy<int>(std::forward<Input>(input), "{}"); };
+
+TEST(LazyScanTest, TemporaryStringIsRejected) {
+    static_assert(!can_scan_lazy_from<std::string>);
+    static_assert(can_scan_lazy_from<const std::string&>);
+    static_assert(can_scan_lazy_from<std::string_view>);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "match.hpp"
+#include "scan.hpp"
+
+namespace {
+
+constexpr std::string_view access_log = "GET /index 200 0.25\n"
+                                        "POST /login 302 1.5\n"
+                                        "garbage line\n"
+                                        "GET /img x 0.5\n"
+                                        "GET /api 404 2e-3";
+
+}  // namespace
+
+// --- Match-Only Tests ---
+
+TEST(MatchTest, StructureOnly) {
+    auto matched = stdx::matches("id=42 name=bob", "id={%d} name={%s}");
+    ASSERT_TRUE(matched.has_value());
+    EXPECT_TRUE(matched.value());
+
+    // Структура совпадает, хотя значение не является числом: конверсия не выполняется.
+    EXPECT_TRUE(stdx::matches("id=xx name=bob", "id={%d} name={%s}").value());
+    EXPECT_FALSE(stdx::matches("id=42 nick=bob", "id={%d} name={%s}").value());
+}
+
+TEST(MatchTest, LexicalCheck) {
+    constexpr auto lexical = stdx::match_mode::lexical;
+    EXPECT_TRUE(stdx::matches("id=-42 v=1.5e3", "id={%d} v={%f}", lexical).value());
+    EXPECT_FALSE(stdx::matches("id=xx v=1.5", "id={%d} v={%f}", lexical).value());
+    EXPECT_FALSE(stdx::matches("id=-1 v=1.5", "id={%u} v={%f}", lexical).value());
+    EXPECT_FALSE(stdx::matches("id=+1 v=1.5", "id={%d} v={%f}", lexical).value());
+    EXPECT_FALSE(stdx::matches("id=1 v=.", "id={%d} v={%f}", lexical).value());
+    EXPECT_FALSE(stdx::matches("id=- v=1.5", "id={%d} v={%f}", lexical).value());
+    // Как и scan, лексическая проверка принимает число в начале поля и не смотрит на остаток.
+    EXPECT_TRUE(stdx::matches("id=12abc v=1.5", "id={%d} v={%f}", lexical).value());
+    EXPECT_TRUE(stdx::matches("id=1 v=1.5.2", "id={%d} v={%f}", lexical).value());
+    EXPECT_TRUE(stdx::matches("id=1 v=1e", "id={%d} v={%f}", lexical).value());
+    EXPECT_TRUE(stdx::matches("id=1 v=nano", "id={%d} v={%f}", lexical).value());
+    EXPECT_TRUE(stdx::matches("id=1 v=-INF", "id={%d} v={%f}", lexical).value());
+    EXPECT_TRUE(stdx::matches("id=1 v=.5", "id={%d} v={%f}", lexical).value());
+    EXPECT_TRUE(stdx::matches("anything goes", "{} {%s}", lexical).value());
+}
+
+TEST(MatchTest, LexicalCheckAgreesWithScan) {
+    constexpr std::string_view format = "{%d};{%u};{%f}";
+    for(std::string_view line : {"1;2;3.5", "-7;0;1e10", "x;2;3", "1;-2;3", "1;2;abc", "1;2;-.25", "12abc;2;3",
+                                 "1;7z;3", "1;+2;3", "+1;2;3", "-;2;3", "1;2;1.5.2", "1;2;1e", "1;2;1e+", "1;2;.",
+                                 "1;2;-.", "1;2;.e5", "1;2;INFinity", "1;2;-nan(x)", "1;2;in", "1;2;0x1p3",
+                                 "1;2; 3", "1;2;", ";2;3"}) {
+        auto matched = stdx::matches(line, format, stdx::match_mode::lexical).value();
+        auto scanned = stdx::scan<int, unsigned int, double>(line, format);
+        EXPECT_EQ(matched, scanned.has_value()) << line;
+    }
+}
+
+TEST(MatchTest, FixedWidthFields) {
+    auto matcher = stdx::scan_matcher::compile("{%4d}{%6f}", stdx::match_mode::lexical);
+    ASSERT_TRUE(matcher.has_value());
+    EXPECT_EQ(matcher->fields_count(), 2u);
+    EXPECT_TRUE(matcher->matches("0001   1.5"));
+    EXPECT_FALSE(matcher->matches("0001 1.5"));
+    EXPECT_FALSE(matcher->matches("ab01   1.5"));
+}
+
+TEST(MatchTest, FailInvalidFormat) {
+    auto matched = stdx::matches("1", "{%x}");
+    ASSERT_FALSE(matched.has_value());
+    EXPECT_EQ(matched.error().code, stdx::details::scan_errc::unexpected_specifier);
+
+    auto adjacent = stdx::scan_matcher::compile("{%d}{%d}");
+    ASSERT_FALSE(adjacent.has_value());
+    EXPECT_EQ(adjacent.error().code, stdx::details::scan_errc::index_out_of_bounds);
+}
+
+TEST(MatchTest, CountMatches) {
+    EXPECT_EQ(stdx::count_matches(access_log, "{%s} {%s} {%u} {%f}").value(), 4u);
+    EXPECT_EQ(stdx::count_matches(access_log, "{%s} {%s} {%u} {%f}", stdx::match_mode::lexical).value(), 3u);
+    EXPECT_EQ(stdx::count_matches(access_log, "GET {} {%u} {}").value(), 3u);
+    EXPECT_EQ(stdx::count_matches(access_log, "{}").value(), 5u);
+    EXPECT_EQ(stdx::count_matches("", "{}").value(), 0u);
+    EXPECT_EQ(stdx::count_matches("a\n\nb\n", "{}").value(), 3u);
+}
+
+TEST(MatchTest, FilterMatchesReturnsLineOffsets) {
+    auto offsets = stdx::filter_matches(access_log, "GET {%s} {%u} {%f}", stdx::match_mode::lexical);
+    ASSERT_TRUE(offsets.has_value());
+    ASSERT_EQ(offsets->size(), 2u);
+    EXPECT_EQ(offsets->at(0), 0u);
+    EXPECT_EQ(access_log.substr(offsets->at(1)), "GET /api 404 2e-3");
+}
+
+TEST(MatchTest, AnchorLiteralInsideLine) {
+    // Самый длинный литерал стоит в середине строки, а перед ним есть строки без него.
+    std::string buffer;
+    std::vector<std::size_t> expected;
+    for(int i = 0; i < 100; ++i) {
+        if(i % 7 == 0) {
+            expected.push_back(buffer.size());
+            buffer += "k" + std::to_string(i) + " status=ready v=" + std::to_string(i) + "\n";
+        }
+        else {
+            buffer += "k" + std::to_string(i) + " status=idle\n";
+        }
+    }
+    auto matcher = stdx::scan_matcher::compile("k{%u} status=ready v={%d}", stdx::match_mode::lexical);
+    ASSERT_TRUE(matcher.has_value());
+    EXPECT_EQ(stdx::filter_matches(buffer, matcher.value()), expected);
+    EXPECT_EQ(stdx::count_matches(buffer, matcher.value()), expected.size());
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace {
+
+std::string make_lines(int count) {
+    std::string buffer;
+    for(int i = 0; i < count; ++i) {
+        buffer += (i % 10 == 0 ? "bad line" : "v=" + std::to_string(i)) + "\n";
+    }
+    return buffer;
+}
+
+}  // namespace
+
+// --- Parallel Scan Tests ---
+
+TEST(ParallelTest, SplitChunksOnLineBoundaries) {
+    auto chunks = stdx::details::split_chunks("aa\nbbbb\nc\ndd", 3);
+    EXPECT_EQ(chunks, (std::vector<std::string_view> {"aa\n", "bbbb\n", "c\ndd"}));
+}
+
+TEST(ParallelTest, OrderedMatchesSequentialScan) {
+    const auto buffer = make_lines(1000);
+    auto results      = stdx::scan_parallel<int>(buffer, "v={%d}", {.threads = 4, .chunk_size = 64});
+    ASSERT_TRUE(results.has_value());
+    ASSERT_EQ(results->size(), 1000u);
+
+    for(int i = 0; i < 1000; ++i) {
+        const auto& line = (*results)[i];
+        ASSERT_EQ(line.has_value(), i % 10 != 0) << "line " << i;
+        if(line) {
+            EXPECT_EQ(std::get<0>(line->result), i);
+        }
+    }
+}
+
+TEST(ParallelTest, ManyThreadsMatchSequentialScan) {
+    std::string buffer;
+    for(int i = 0; i < 5000; ++i) {
+        buffer += "id=" + std::to_string(i) + (i % 7 == 0 ? " v=x" : " v=" + std::to_string(i * 3)) +
+                  (i % 13 == 0 ? "" : " end") + "\n";
+    }
+    const auto pattern = stdx::scan_pattern<int, int>::compile("id={%d} v={%d} end").value();
+    auto results       = stdx::scan_parallel(buffer, pattern, {.threads = 8, .chunk_size = 256});
+
+    std::vector<std::expected<stdx::details::scan_result<int, int>, stdx::details::scan_error>> expected;
+    std::size_t position = 0;
+    while(position < buffer.size()) {
+        expected.push_back(pattern.scan(stdx::details::next_line(buffer, position)));
+    }
+    ASSERT_EQ(results.size(), expected.size());
+    for(std::size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i].has_value(), expected[i].has_value()) << "line " << i;
+        if(results[i]) {
+            EXPECT_EQ(results[i]->result, expected[i]->result) << "line " << i;
+        }
+        else {
+            EXPECT_EQ(results[i].error().code, expected[i].error().code) << "line " << i;
+            EXPECT_EQ(results[i].error().field, expected[i].error().field) << "line " << i;
+            EXPECT_EQ(results[i].error().offset, expected[i].error().offset) << "line " << i;
+        }
+    }
+}
+
+TEST(ParallelTest, TaskExceptionStopsPoolAndIsRethrown) {
+    std::atomic<int> started {0};
+    EXPECT_THROW(stdx::details::run_work_stealing(1000, 4,
+                                                  [&](std::size_t, std::size_t) {
+                                                      if(started++ == 0) {
+                                                          throw std::runtime_error("task failed");
+                                                      }
+                                                      std::this_thread::sleep_for(std::chrono::microseconds(100));
+                                                  }),
+                 std::runtime_error);
+    // Остальные исполнители остановились, не разобрав очередь до конца.
+    EXPECT_LT(started.load(), 1000);
+}
+
+TEST(ParallelTest, SinkReceivesLineOffsets) {
+    const auto buffer  = make_lines(1000);
+    const auto pattern = stdx::scan_pattern<int>::compile("v={%d}").value();
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, int>> values;
+    std::size_t errors = 0;
+    stdx::scan_parallel(
+        buffer, pattern,
+        [&](std::size_t offset, std::expected<stdx::details::scan_result<int>, stdx::details::scan_error>&& line) {
+            std::lock_guard lock {mutex};
+            if(line) {
+                values.emplace_back(offset, std::get<0>(line->result));
+            }
+            else {
+                ++errors;
+            }
+        },
+        {.threads = 3, .chunk_size = 100});
+
+    EXPECT_EQ(errors, 100u);
+    ASSERT_EQ(values.size(), 900u);
+    for(const auto& [offset, value] : values) {
+        // Смещение указывает на начало той самой строки, из которой получено значение.
+        EXPECT_EQ(offset == 0 || buffer[offset - 1] == '\n', true) << offset;
+        EXPECT_TRUE(buffer.substr(offset).starts_with("v=" + std::to_string(value) + "\n")) << offset;
+    }
+}
+
+TEST(ParallelTest, SinkExceptionIsRethrown) {
+    const auto buffer = make_lines(1000);
+    auto scan         = [&] {
+        return stdx::scan_parallel<int>(
+            buffer, "v={%d}",
+            [](std::size_t, std::expected<stdx::details::scan_result<int>, stdx::details::scan_error>&& line) {
+                if(line && std::get<0>(line->result) == 501) {
+                    throw std::runtime_error("sink failed");
+                }
+            },
+            {.threads = 4, .chunk_size = 64});
+    };
+    EXPECT_THROW(scan(), std::runtime_error);
+}
+
+TEST(ParallelTest, LastLineWithoutNewline) {
+    auto results = stdx::scan_parallel<int>("1\n2\n3", "{%d}", {.threads = 2, .chunk_size = 2});
+    ASSERT_TRUE(results.has_value());
+    ASSERT_EQ(results->size(), 3u);
+    EXPECT_EQ(std::get<0>(results->back()->result), 3);
+}
+
+TEST(ParallelTest, EmptyBuffer) {
+    auto results = stdx::scan_parallel<int>("", "{%d}");
+    ASSERT_TRUE(results.has_value());
+    EXPECT_TRUE(results->empty());
+}
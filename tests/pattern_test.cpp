@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "scan.hpp"
+
+// --- Compiled Pattern Tests ---
+
+TEST(PatternTest, CompileAndScanMixedSpecifiers) {
+    auto pattern = stdx::scan_pattern<int, std::string, double>::compile("{%d} {%s} {%f}");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto result = pattern->scan("100 hello 2.5");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result.value().result), 100);
+    EXPECT_EQ(std::get<1>(result.value().result), "hello");
+    EXPECT_DOUBLE_EQ(std::get<2>(result.value().result), 2.5);
+}
+
+TEST(PatternTest, ReuseForManyInputs) {
+    auto pattern = stdx::scan_pattern<int, std::string>::compile("ID: {%d} Name: {%s}");
+    ASSERT_TRUE(pattern.has_value());
+
+    for(int id = 0; id < 10; ++id) {
+        auto input  = "ID: " + std::to_string(id) + " Name: Smith";
+        auto result = stdx::scan(input, pattern.value());
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(std::get<0>(result.value().result), id);
+        EXPECT_EQ(std::get<1>(result.value().result), "Smith");
+    }
+}
+
+TEST(PatternTest, LeadingAndTrailingText) {
+    auto pattern = stdx::scan_pattern<int>::compile("[Value={%d}]");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto result = pattern->scan("[Value=50]");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result.value().result), 50);
+}
+
+TEST(PatternTest, CopiedPatternOwnsFormat) {
+    std::string format = "{} {%d}";
+    auto pattern       = stdx::scan_pattern<std::string, int8_t>::compile(format);
+    ASSERT_TRUE(pattern.has_value());
+    format.assign("garbage garbage garbage garbage");
+
+    auto copy   = pattern.value();
+    auto result = copy.scan("start 99");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result.value().result), "start");
+    EXPECT_EQ(std::get<1>(result.value().result), 99);
+}
+
+TEST(PatternTest, MatchesScanErrors) {
+    auto pattern = stdx::scan_pattern<int8_t>::compile("{}");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto result = pattern->scan("242");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().message(), stdx::scan<int8_t>("242", "{}").error().message());
+}
+
+TEST(PatternTest, FailLiteralTextMismatch) {
+    auto pattern = stdx::scan_pattern<int>::compile("ID: {%d}");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto result = pattern->scan("ID 123");
+    EXPECT_FALSE(result.has_value());
+    EXPECT_NE(result.error().message().find("Unformatted text in input and format string are different"),
+              std::string::npos);
+}
+
+// --- Compile Error Tests ---
+
+TEST(PatternTest, FailMismatchedSpecifierCount) {
+    auto pattern = stdx::scan_pattern<int, std::string>::compile("{%d}");
+    EXPECT_FALSE(pattern.has_value());
+    EXPECT_NE(pattern.error().message().find("Mismatched number of format specifiers and target types"),
+              std::string::npos);
+}
+
+TEST(PatternTest, FailUnknownSpecifier) {
+    auto pattern = stdx::scan_pattern<std::string>::compile("{s}");
+    EXPECT_FALSE(pattern.has_value());
+    EXPECT_EQ(pattern.error().message(), "Unexpected result. Wrong or too long format specifier.");
+}
+
+TEST(PatternTest, FailSpecifierTypeMismatch) {
+    auto pattern = stdx::scan_pattern<int, std::string>::compile("{%d} {%d}");
+    EXPECT_FALSE(pattern.has_value());
+    EXPECT_EQ(pattern.error().message(), "Unexpected result. Type mismatch: 'd' specifier requires an integral type.");
+}
+
+TEST(PatternTest, FailAdjacentPlaceholders) {
+    auto pattern = stdx::scan_pattern<int, int>::compile("{%d}{%d}");
+    EXPECT_FALSE(pattern.has_value());
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pipeline.hpp"
+#include "test_helpers.hpp"
+
+using test_helpers::numbered_lines;
+
+namespace {
+
+// Функция чтения из строки, отдающая не больше step байт за вызов.
+stdx::read_function string_reader(std::string content, std::size_t step) {
+    return [content = std::move(content), step, position = std::size_t {0}](char* buffer,
+                                                                           std::size_t size) mutable -> std::ptrdiff_t {
+        const std::size_t count = std::min({size, step, content.size() - position});
+        std::memcpy(buffer, content.data() + position, count);
+        position += count;
+        return static_cast<std::ptrdiff_t>(count);
+    };
+}
+
+// Все строки и ошибки конвейера в порядке следования; ошибка записывается как "!" и код.
+std::vector<std::string> drain(stdx::details::line_pipeline& pipeline) {
+    std::vector<std::string> items;
+    while(const auto* chunk = pipeline.next()) {
+        for(std::size_t i = 0; i < chunk->lines(); ++i) {
+            items.emplace_back(chunk->line(i));
+        }
+        if(chunk->error) {
+            items.push_back("!" + std::to_string(static_cast<int>(chunk->error.value())));
+        }
+    }
+    return items;
+}
+
+std::string error_item(stdx::details::scan_errc code) {
+    return "!" + std::to_string(static_cast<int>(code));
+}
+
+}  // namespace
+
+// --- Line Pipeline Tests ---
+
+TEST(LinePipelineTest, LinesSplitAcrossReadsAndChunks) {
+    const auto content = numbered_lines(300);
+    stdx::details::line_pipeline pipeline(string_reader(content, 7), {.chunk_size = 64, .queue_depth = 2});
+
+    auto lines = drain(pipeline);
+    ASSERT_EQ(lines.size(), 300u);
+    for(int i = 0; i < 300; ++i) {
+        EXPECT_EQ(lines[i], "id=" + std::to_string(i * 7919) + " name=user" + std::to_string(i));
+    }
+    EXPECT_EQ(pipeline.next(), nullptr);
+}
+
+TEST(LinePipelineTest, LastLineWithoutNewlineAndEmptyLines) {
+    stdx::details::line_pipeline pipeline(string_reader("a\n\nb\nlast", 3), {.chunk_size = 8, .queue_depth = 1});
+    EXPECT_EQ(drain(pipeline), (std::vector<std::string> {"a", "", "b", "last"}));
+}
+
+TEST(LinePipelineTest, RecordTooLongIsSkipped) {
+    const std::string content = "short\n" + std::string(40, 'x') + "\nafter\n" + std::string(25, 'y') + "z";
+    stdx::details::line_pipeline pipeline(string_reader(content, 5), {.chunk_size = 16, .queue_depth = 1});
+    const auto too_long = error_item(stdx::details::scan_errc::record_too_long);
+    EXPECT_EQ(drain(pipeline), (std::vector<std::string> {"short", too_long, "after", too_long}));
+}
+
+TEST(LinePipelineTest, ReadErrorEndsStream) {
+    int calls = 0;
+    stdx::details::line_pipeline pipeline(
+        [&calls](char* buffer, std::size_t) -> std::ptrdiff_t {
+            if(++calls > 1) {
+                return -1;
+            }
+            std::memcpy(buffer, "1\n2\npartial", 11);
+            return 11;
+        },
+        {.chunk_size = 32, .queue_depth = 1});
+    EXPECT_EQ(drain(pipeline),
+              (std::vector<std::string> {"1", "2", error_item(stdx::details::scan_errc::stream_read_failed)}));
+}
+
+TEST(LinePipelineTest, SlowConsumerStopsReader) {
+    std::atomic<int> reads {0};
+    {
+        // Бесконечный поток: каждое чтение даёт одну строку.
+        stdx::details::line_pipeline pipeline(
+            [&reads](char* buffer, std::size_t) -> std::ptrdiff_t {
+                ++reads;
+                std::memcpy(buffer, "line\n", 5);
+                return 5;
+            },
+            {.chunk_size = 64, .queue_depth = 3});
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Потребитель ничего не забрал: прочитано не больше кусков, чем есть в обороте.
+        EXPECT_LE(reads.load(), 3 + 2);
+
+        ASSERT_NE(pipeline.next(), nullptr);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_LE(reads.load(), 3 + 2 + 1);
+        // Разрушение конвейера останавливает ожидающий поток чтения.
+    }
+    EXPECT_GE(reads.load(), 1);
+}
+
+#if defined(__cpp_lib_generator)
+
+// --- Pipelined Scan Tests ---
+
+TEST(ScanLinesTest, ForLoopOverRecords) {
+    const auto content = numbered_lines(500);
+    std::istringstream input {content};
+    auto records = stdx::scan_lines<int, std::string>(input, "id={%d} name={%s}", {.chunk_size = 128});
+    ASSERT_TRUE(records.has_value());
+
+    int index = 0;
+    for(auto&& record : records.value()) {
+        ASSERT_TRUE(record.has_value()) << record.error().message();
+        EXPECT_EQ(std::get<0>(record->result), index * 7919);
+        EXPECT_EQ(std::get<1>(record->result), "user" + std::to_string(index));
+        ++index;
+    }
+    EXPECT_EQ(index, 500);
+}
+
+TEST(ScanLinesTest, ErrorsArriveInPlace) {
+    const std::string content = "1\nx\n" + std::string(40, '9') + "\n4\n";
+    auto records = stdx::scan_lines<int>(string_reader(content, 64), "{%d}", {.chunk_size = 16});
+    ASSERT_TRUE(records.has_value());
+
+    std::vector<stdx::details::scan_errc> errors;
+    std::vector<int> values;
+    for(auto&& record : records.value()) {
+        if(record) {
+            values.push_back(std::get<0>(record->result));
+        }
+        else {
+            errors.push_back(record.error().code);
+        }
+    }
+    EXPECT_EQ(values, (std::vector<int> {1, 4}));
+    EXPECT_EQ(errors, (std::vector {stdx::details::scan_errc::invalid_integer,
+                                    stdx::details::scan_errc::record_too_long}));
+}
+
+TEST(ScanLinesTest, BreakStopsReader) {
+    auto records = stdx::scan_lines<int>(
+        [](char* buffer, std::size_t) -> std::ptrdiff_t {
+            std::memcpy(buffer, "7\n", 2);
+            return 2;
+        },
+        "{%d}");
+    ASSERT_TRUE(records.has_value());
+    int seen = 0;
+    for(auto&& record : records.value()) {
+        EXPECT_EQ(std::get<0>(record->result), 7);
+        if(++seen == 100) {
+            break;
+        }
+    }
+    EXPECT_EQ(seen, 100);
+}
+
+TEST(ScanLinesTest, FailInvalidFormat) {
+    std::istringstream input {"1\n"};
+    auto records = stdx::scan_lines<int>(input, "{%x}");
+    ASSERT_FALSE(records.has_value());
+    EXPECT_EQ(records.error().code, stdx::details::scan_errc::unexpected_specifier);
+}
+
+#endif
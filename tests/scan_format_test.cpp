@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "scan.hpp"
+
+// --- Compile-time Checked Format Tests ---
+
+TEST(ScanFormatTest, CheckedMixedSpecifiers) {
+    auto result = stdx::scan_checked<int, std::string, double>("100 hello 2.5", "{%d} {%s} {%f}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result.value().result), 100);
+    EXPECT_EQ(std::get<1>(result.value().result), "hello");
+    EXPECT_DOUBLE_EQ(std::get<2>(result.value().result), 2.5);
+}
+
+TEST(ScanFormatTest, CheckedWithLiteralText) {
+    auto result = stdx::scan_checked<int, std::string>("ID: 123 Name: Smith", "ID: {%d} Name: {%s}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result.value().result), 123);
+    EXPECT_EQ(std::get<1>(result.value().result), "Smith");
+}
+
+TEST(ScanFormatTest, FormatObjectIsReusable) {
+    constexpr stdx::scan_format<unsigned int, float> format {"[{%u}] {}"};
+    static_assert(format.get() == "[{%u}] {}");
+
+    auto first = stdx::scan("[7] 1.5", format);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(std::get<0>(first.value().result), 7u);
+    EXPECT_FLOAT_EQ(std::get<1>(first.value().result), 1.5f);
+
+    auto second = stdx::scan("[8] 2.5", format);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(std::get<0>(second.value().result), 8u);
+}
+
+TEST(ScanFormatTest, RuntimeConversionErrorsMatchScan) {
+    auto result = stdx::scan_checked<unsigned short int>("65536", "{%u}");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().message(), "Unexpected result.Failed to convert to <unsigned short int>.");
+}
+
+TEST(ScanFormatTest, FailLiteralTextMismatch) {
+    auto result = stdx::scan_checked<int>("ID 123", "ID: {%d}");
+    EXPECT_FALSE(result.has_value());
+    EXPECT_NE(result.error().message().find("Unformatted text in input and format string are different"),
+              std::string::npos);
+}
+
+TEST(ScanFormatTest, SkipPlaceholder) {
+    static constexpr stdx::scan_format<stdx::skip, int, std::pmr::string> format {"{*} id={%d} {*}"};
+    auto result = format.scan("GET id=5 trailing");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<1>(result->result), 5);
+    EXPECT_TRUE(std::get<2>(result->result).empty());
+
+    auto pattern = stdx::scan_pattern<stdx::skip, int>::compile("{*} id={%d}");
+    ASSERT_TRUE(pattern.has_value());
+    auto scanned = pattern->scan("anything id=9");
+    ASSERT_TRUE(scanned.has_value());
+    EXPECT_EQ(std::get<1>(scanned->result), 9);
+}
+
+// Несоответствие формата и типов отвергается при компиляции: конструктор scan_format и ограничение scan_static
+// используют одну проверку.
+template<typename T, stdx::details::format_literal Format>
+constexpr bool scan_static_accepts = requires { stdx::scan_static<Format, T>(""); };
+
+static_assert(stdx::details::is_valid_scan_format<int>("{%d}"));
+static_assert(!stdx::details::is_valid_scan_format<int>("{%s}"));
+static_assert(!stdx::details::is_valid_scan_format<unsigned int>("{%f}"));
+static_assert(!stdx::details::is_valid_scan_format<int, int>("{%d}"));
+static_assert(!stdx::details::is_valid_scan_format<int>("{%x}"));
+static_assert(scan_static_accepts<int, "id={%d}">);
+static_assert(!scan_static_accepts<int, "id={%s}">);
+static_assert(!scan_static_accepts<double, "id={%u}">);
+
+TEST(ScanFormatTest, StaticFormatMatchesScanFormat) {
+    static constexpr stdx::scan_format<unsigned int, std::string, int, double> format {"[{%u}] {%s} id={%d} {}"};
+    for(std::string_view line : {"[7] GET id=42 1.5", "[7] GET id=x 1.5", "[x] GET id=1 1.5", "7 GET id=1 1.5",
+                                 "[7] GET id=1 nan"}) {
+        auto expected = format.scan(line);
+        auto result   = stdx::scan_static<"[{%u}] {%s} id={%d} {}", unsigned int, std::string, int, double>(line);
+        ASSERT_EQ(result.has_value(), expected.has_value()) << line;
+        if(result) {
+            EXPECT_EQ(std::get<0>(result->result), std::get<0>(expected->result)) << line;
+            EXPECT_EQ(std::get<1>(result->result), std::get<1>(expected->result)) << line;
+            EXPECT_EQ(std::get<2>(result->result), std::get<2>(expected->result)) << line;
+        }
+        else {
+            EXPECT_EQ(result.error().code, expected.error().code) << line;
+            EXPECT_EQ(result.error().field, expected.error().field) << line;
+            EXPECT_EQ(result.error().offset, expected.error().offset) << line;
+        }
+    }
+}
+
+TEST(ScanFormatTest, StaticFormatSkipsFields) {
+    auto result = stdx::scan_static<"{*} id={%d}", stdx::skip, int>("anything id=9");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<1>(result->result), 9);
+}
@@ -52,13 +52,13 @@ TEST(ScanTest, ParseSingleInt8_t_EmptySpecifier) {
 TEST(ScanTest, ParseSingleInt8_t_EmptySpecifier_FAILURE) {
     auto result = stdx::scan<int8_t>("242", "{}");
     ASSERT_TRUE(!result);
-    EXPECT_EQ(result.error().message, "Unexpected result. Integer out of range for target type {}.");
+    EXPECT_EQ(result.error().message(), "Unexpected result. Integer out of range for target type {}.");
 }
 
 TEST(ScanTest, ParseSingleInt32_t_EmptySpecifier_FAILURE) {
     auto result = stdx::scan<int>("3000000000", "{}");
     ASSERT_TRUE(!result);
-    EXPECT_EQ(result.error().message, "Unexpected result. Integer out of range for target type {}.");
+    EXPECT_EQ(result.error().message(), "Unexpected result. Integer out of range for target type {}.");
 }
 
 TEST(ScanTest, ParseSingleUint32_t_EmptySpecifier) {
@@ -82,7 +82,7 @@ TEST(ScanTest, ParseSingleFloat_EmptySpecifier) {
 TEST(ScanTest, ParseSingleFloat_EmptySpecifier_FAILURE) {
     auto result = stdx::scan<float>("-3.5e+38", "{}");
     ASSERT_TRUE(!result);
-    EXPECT_EQ(result.error().message, "Unexpected result. Double value out of range for float target type {}.");
+    EXPECT_EQ(result.error().message(), "Unexpected result. Double value out of range for float target type {}.");
 }
 
 TEST(ScanTest, ParseSingleDouble_EmptySpecifier) {
@@ -112,7 +112,7 @@ TEST(ScanTest, ParseSingleUnsignedShortInt_U_Specifier) {
 TEST(ScanTest, ParseSingleUnsignedShortInt_U_Specifier_FAILURE) {
     auto result = stdx::scan<unsigned short int>("65536", "{%u}");
     ASSERT_TRUE(!result);
-    EXPECT_EQ(result.error().message, "Unexpected result.Failed to convert to <unsigned short int>.");
+    EXPECT_EQ(result.error().message(), "Unexpected result.Failed to convert to <unsigned short int>.");
 }
 
 TEST(ScanTest, ParseSingleDouble_F_Specifier) {
@@ -124,7 +124,7 @@ TEST(ScanTest, ParseSingleDouble_F_Specifier) {
 TEST(ScanTest, ParseSingleInt8_t_D_Specifier_FAILURE) {
     auto result = stdx::scan<signed char>("170", "{%d}");
     ASSERT_TRUE(!result);
-    EXPECT_EQ(result.error().message, "Unexpected result.Failed to convert to <signed char>.");
+    EXPECT_EQ(result.error().message(), "Unexpected result.Failed to convert to <signed char>.");
 }
 
 TEST(ScanTest, ParseSingleInt32_t_D_Specifier) {
@@ -183,20 +183,20 @@ TEST(ScanTest, ParseWithLeadingAndTrailingText) {
 TEST(ScanTest, FailWrongSpecifierForType) {
     auto result = stdx::scan<int>("not_a_number", "{%d}");
     EXPECT_FALSE(result.has_value()) << "Scan should fail due to type mismatch";
-    EXPECT_NE(result.error().message.find("Failed to convert to <int>."), std::string::npos);
+    EXPECT_NE(result.error().message().find("Failed to convert to <int>."), std::string::npos);
 }
 
 TEST(ScanTest, FailMismatchedSpecifierCount) {
     auto result = stdx::scan<int, std::string>("100", "{%d}");
     EXPECT_FALSE(result.has_value()) << "Scan should fail due to mismatched type's count";
-    EXPECT_NE(result.error().message.find(" Mismatched number of format specifiers and target types"),
+    EXPECT_NE(result.error().message().find(" Mismatched number of format specifiers and target types"),
               std::string::npos);
 }
 
 TEST(ScanTest, FailInvalidFormat_UnmatchedBrace) {
     auto result = stdx::scan<int>("100", "{%d");  // Не хватает закрывающей placeholder.
     EXPECT_FALSE(result.has_value()) << "Scan should fail due to invalid format";
-    EXPECT_NE(result.error().message.find("Unformatted text in input and format string are different"),
+    EXPECT_NE(result.error().message().find("Unformatted text in input and format string are different"),
               std::string::npos);
 }
 
@@ -204,12 +204,100 @@ TEST(ScanTest, FailLiteralTextMismatch) {
     auto result =
         stdx::scan<int>("ID 123", "ID: {%d}");  // Форматная строка ожидает 'ID: ', а строка ввода имеет вид 'ID '
     EXPECT_FALSE(result.has_value()) << "Scan should fail due to literal text mismatch";
-    EXPECT_NE(result.error().message.find("Unformatted text in input and format string are different"),
+    EXPECT_NE(result.error().message().find("Unformatted text in input and format string are different"),
               std::string::npos);
 }
 
 TEST(ScanTest, FailEmptyInputNonEmptyFormat) {
     auto result = stdx::scan<int>("", "{%d}");
     EXPECT_FALSE(result.has_value()) << "Scan should fail for empty input";
-    EXPECT_NE(result.error().message.find("Failed to convert to <int>"), std::string::npos);
+    EXPECT_NE(result.error().message().find("Failed to convert to <int>"), std::string::npos);
+}
+
+TEST(ScanTest, ErrorCarriesCodeFieldAndOffset) {
+    auto conversion = stdx::scan<int, int>("a=1 b=x2", "a={%d} b={%d}");
+    ASSERT_FALSE(conversion.has_value());
+    EXPECT_EQ(conversion.error().code, stdx::details::scan_errc::invalid_integer);
+    EXPECT_EQ(conversion.error().field, 1u);
+    EXPECT_EQ(conversion.error().offset, 6u);
+
+    auto range = stdx::scan<std::string_view, signed char>("key: 300", "{}: {}");
+    ASSERT_FALSE(range.has_value());
+    EXPECT_EQ(range.error().code, stdx::details::scan_errc::integer_out_of_range);
+    EXPECT_EQ(range.error().field, 1u);
+    EXPECT_EQ(range.error().offset, 5u);
+
+    // Для несовпадения литерала field - индекс ненайденного литерала, offset - начало его поиска.
+    auto literal = stdx::scan<int, int>("a=1 b=2", "a={%d}, b={%d}");
+    ASSERT_FALSE(literal.has_value());
+    EXPECT_EQ(literal.error().code, stdx::details::scan_errc::literal_mismatch);
+    EXPECT_EQ(literal.error().field, 1u);
+    EXPECT_EQ(literal.error().offset, 2u);
+
+    auto pattern = stdx::scan_pattern<int, int>::compile("a={%d}, b={%d}").value();
+    auto matched = pattern.scan("a=1, b=?");
+    ASSERT_FALSE(matched.has_value());
+    EXPECT_EQ(matched.error().code, stdx::details::scan_errc::invalid_integer);
+    EXPECT_EQ(matched.error().field, 1u);
+    EXPECT_EQ(matched.error().offset, 7u);
+    EXPECT_EQ(matched.error().message(), "Unexpected result.Failed to convert to <int>.");
+}
+
+// --- Zero-Copy String Tests ---
+
+TEST(ScanTest, StringViewSpecifierPointsIntoInput) {
+    const std::string input = "user=some_rather_long_user_name id=100";
+    auto result             = stdx::scan<std::string_view, int>(input, "user={%s} id={%d}");
+    ASSERT_TRUE(result.has_value());
+    auto name = std::get<0>(result->result);
+    EXPECT_EQ(name, "some_rather_long_user_name");
+    EXPECT_EQ(name.data(), input.data() + 5);
+}
+
+TEST(ScanTest, BorrowedResultKeepsSource) {
+    const std::string input = "GET /index.html 200";
+    auto result             = stdx::scan_borrowed<std::string_view, std::string_view, int>(input, "{%s} {} {%d}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->source.data(), input.data());
+    EXPECT_EQ(std::get<1>(result->result), "/index.html");
+    EXPECT_EQ(std::get<1>(result->result).data(), input.data() + 4);
+    EXPECT_EQ(std::get<2>(result->result), 200);
+
+    auto pattern  = stdx::scan_pattern<std::string_view, int>::compile("{} {%d}").value();
+    auto borrowed = stdx::scan_borrowed(std::string_view {input}.substr(4), pattern);
+    ASSERT_TRUE(borrowed.has_value());
+    EXPECT_EQ(std::get<0>(borrowed->result), "/index.html");
+
+    auto failed = stdx::scan_borrowed<int>(input, "{%d}");
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error().code, stdx::details::scan_errc::invalid_integer);
+}
+
+template<typename Input>
+concept can_borrow_from = requires(Input&& input) {
+    stdx::scan_borrowed<std::string_view>(std::forward<Input>(input), "{}");
+};
+
+TEST(ScanTest, BorrowingFromTemporaryStringDoesNotCompile) {
+    static_assert(!can_borrow_from<std::string>);
+    static_assert(can_borrow_from<const std::string&>);
+    static_assert(can_borrow_from<std::string&>);
+    static_assert(can_borrow_from<std::string_view>);
+    static_assert(can_borrow_from<const char (&)[8]>);
+}
+
+TEST(ScanTest, SkipPlaceholderMatchesWithoutConversion) {
+    auto result = stdx::scan<int, stdx::skip, double>("7 not-a-number 2.5", "{%d} {*} {%f}");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(result->result), 7);
+    EXPECT_DOUBLE_EQ(std::get<2>(result->result), 2.5);
+
+    // Пропущенное поле любого типа остаётся значением по умолчанию, даже если его текст не разобрался бы.
+    auto untouched = stdx::scan<int, int>("1 x", "{%d} {*}");
+    ASSERT_TRUE(untouched.has_value());
+    EXPECT_EQ(std::get<1>(untouched->result), 0);
+
+    auto mismatch = stdx::scan<stdx::skip>("42", "{%d}");
+    ASSERT_FALSE(mismatch.has_value());
+    EXPECT_EQ(mismatch.error().code, stdx::details::scan_errc::integral_type_mismatch);
 }
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "match.hpp"
+#include "pattern.hpp"
+#include "scan.hpp"
+#include "search.hpp"
+#include "test_helpers.hpp"
+
+namespace {
+
+using test_helpers::random_text;
+
+// Длинный литерал из повторяющегося блока с изменённым символом: периодичные и почти периодичные литералы -
+// самый трудный случай для критической факторизации.
+std::string periodic_text(std::mt19937& rng, std::size_t size, std::string_view alphabet) {
+    auto block = random_text(rng, 1 + rng() % 4, alphabet);
+    std::string text;
+    while(text.size() < size) {
+        text += block;
+    }
+    text.resize(size);
+    if(rng() % 2 == 0) {
+        text[rng() % size] = alphabet[rng() % alphabet.size()];
+    }
+    return text;
+}
+
+std::size_t two_way(std::string_view haystack, std::string_view needle) {
+    return stdx::details::two_way_find(haystack, needle, stdx::details::plan_literal(needle));
+}
+
+}  // namespace
+
+// --- Linear-Time Literal Search Tests ---
+
+TEST(SearchTest, TwoWayMatchesStringViewFind) {
+    std::mt19937 rng {11};
+    for(int iteration = 0; iteration < 20000; ++iteration) {
+        auto needle   = iteration % 2 == 0 ? random_text(rng, 17 + rng() % 16, "ab")
+                                           : periodic_text(rng, 17 + rng() % 40, "abc");
+        auto haystack = random_text(rng, rng() % 200, "ab") + needle.substr(0, rng() % needle.size()) +
+                        (rng() % 3 == 0 ? needle : "") + random_text(rng, rng() % 50, "abc");
+        EXPECT_EQ(two_way(haystack, needle), std::string_view {haystack}.find(needle))
+            << "haystack: '" << haystack << "' needle: '" << needle << "'";
+    }
+}
+
+TEST(SearchTest, FindLiteralLinearMatchesStringViewFind) {
+    std::mt19937 rng {5};
+    for(int iteration = 0; iteration < 20000; ++iteration) {
+        auto needle   = random_text(rng, 1 + rng() % 30, "a:");
+        auto haystack = random_text(rng, rng() % 300, "a: ");
+        EXPECT_EQ(stdx::details::find_literal_linear(haystack, needle), std::string_view {haystack}.find(needle))
+            << "haystack: '" << haystack << "' needle: '" << needle << "'";
+    }
+}
+
+TEST(SearchTest, PlanIsConstexpr) {
+    constexpr std::string_view needle = "abaabaabaabaabaabaab";
+    constexpr auto plan               = stdx::details::plan_literal(needle);
+    static_assert(plan.critical < needle.size());
+    static_assert(stdx::details::two_way_find("abaabaabaabaabaabaaxabaabaabaabaabaabaab", needle, plan) == 20);
+    static_assert(stdx::details::two_way_find("abaabaabaabaabaabaa", needle, plan) == std::string_view::npos);
+}
+
+TEST(SearchTest, LongLiteralsInAdversarialInput) {
+    // Поле из почти-совпадений с длинным разделителем: граница поля - первое полное вхождение.
+    const std::string separator = std::string(31, 'a') + "b" + std::string(32, 'a');
+    const std::string noise     = std::string(4000, 'a');
+    const std::string line      = "id=7 " + noise + separator + "tail";
+    const std::string format    = "id={%d} {}" + separator + "{}";
+
+    auto scanned = stdx::scan<int, std::string_view, std::string_view>(line, format);
+    ASSERT_TRUE(scanned.has_value()) << scanned.error().message();
+    EXPECT_EQ(std::get<1>(scanned->result).size(), noise.size());
+    EXPECT_EQ(std::get<2>(scanned->result), "tail");
+
+    auto pattern = stdx::scan_pattern<int, std::string_view, std::string_view>::compile(format).value();
+    auto matched = pattern.scan(line);
+    ASSERT_TRUE(matched.has_value());
+    EXPECT_EQ(std::get<1>(matched->result).size(), noise.size());
+
+    auto missing = pattern.scan("id=7 " + noise + "tail");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, stdx::details::scan_errc::literal_mismatch);
+    EXPECT_EQ(missing.error().field, 2u);
+
+    // Построчный режим: длинный литерал ищется только в пределах своей строки.
+    const std::string buffer = "id=1 " + noise + "\n" + line + "\n";
+    std::size_t position     = 0;
+    std::array<std::string_view, 3> fields;
+    EXPECT_FALSE(pattern.match_line(buffer, position, fields));
+    EXPECT_EQ(position, 5 + noise.size() + 1);
+    ASSERT_TRUE(pattern.match_line(buffer, position, fields));
+    EXPECT_EQ(fields[2], "tail");
+    EXPECT_EQ(position, buffer.size());
+
+    EXPECT_EQ(stdx::count_matches(buffer, format).value(), 1u);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include "batch.hpp"
+#include "simd.hpp"
+#include "test_helpers.hpp"
+
+using test_helpers::random_text;
+
+// --- SIMD Literal Matching Tests ---
+
+TEST(SimdTest, FindLiteralMatchesStringViewFind) {
+    std::mt19937 rng {42};
+    for(int iteration = 0; iteration < 20000; ++iteration) {
+        auto haystack = random_text(rng, rng() % 100, "ab,: \n");
+        auto needle   = random_text(rng, 1 + rng() % 5, "ab,: ");
+        EXPECT_EQ(stdx::details::find_literal(haystack, needle), std::string_view {haystack}.find(needle))
+            << "haystack: '" << haystack << "' needle: '" << needle << "'";
+    }
+}
+
+TEST(SimdTest, FindLiteralInLineStopsAtNewline) {
+    std::mt19937 rng {7};
+    for(int iteration = 0; iteration < 20000; ++iteration) {
+        auto haystack = random_text(rng, rng() % 100, "ab,: \n");
+        auto needle   = random_text(rng, 1 + rng() % 5, "ab,: ");
+
+        auto literal  = std::string_view {haystack}.find(needle);
+        auto newline  = std::string_view {haystack}.find('\n');
+        auto hit      = stdx::details::find_literal_in_line(haystack, needle);
+        auto expected = std::min(literal, newline);
+        ASSERT_EQ(hit.position, expected) << "haystack: '" << haystack << "' needle: '" << needle << "'";
+        if(expected != std::string_view::npos) {
+            EXPECT_EQ(hit.newline, newline < literal);
+        }
+    }
+}
+
+#ifdef STDX_SCAN_X86
+TEST(SimdTest, VectorImplementationsAgreeWithScalar) {
+    std::mt19937 rng {3};
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    for(int iteration = 0; iteration < 20000; ++iteration) {
+        auto haystack     = random_text(rng, 1 + rng() % 200, "ab,\n");
+        auto needle       = random_text(rng, 1 + rng() % std::min<std::size_t>(haystack.size(), 8), "ab,");
+        bool stop_newline = rng() % 2 == 0;
+
+        auto scalar = stdx::details::find_literal_scalar(haystack.data(), haystack.size(), needle.data(),
+                                                         needle.size(), 0, stop_newline);
+        auto sse2   = stdx::details::find_literal_sse2(haystack.data(), haystack.size(), needle.data(), needle.size(),
+                                                       stop_newline);
+        EXPECT_EQ(sse2.position, scalar.position);
+        EXPECT_EQ(sse2.newline, scalar.newline);
+        if(has_avx2) {
+            auto avx2 = stdx::details::find_literal_avx2(haystack.data(), haystack.size(), needle.data(),
+                                                         needle.size(), stop_newline);
+            EXPECT_EQ(avx2.position, scalar.position);
+            EXPECT_EQ(avx2.newline, scalar.newline);
+        }
+    }
+}
+#endif
+
+TEST(SimdTest, BatchSinglePassMatchesLineByLine) {
+    std::string_view buffer = "1: a, 2\nbroken: line\n3: b, 4 trailing\n5: c\n6: d, 7";
+    auto batch              = stdx::scan_batch<int, std::string_view, int>(buffer, "{%d}: {}, {%d}");
+    ASSERT_TRUE(batch.has_value());
+
+    ASSERT_EQ(batch->rows, 5u);
+    EXPECT_EQ(batch->column<0>(), (std::vector<int> {1, 0, 3, 0, 6}));
+    EXPECT_EQ(batch->column<2>(), (std::vector<int> {2, 0, 4, 0, 7}));
+    EXPECT_EQ(batch->valid_count(), 3u);
+}
+
+TEST(SimdTest, BatchFormatWithNewlineLiteral) {
+    auto batch = stdx::scan_batch<int, int>("1\n2\n3\n4", "{%d}\n{%d}");
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch->rows, 4u);
+    EXPECT_EQ(batch->valid_count(), 0u);
+}
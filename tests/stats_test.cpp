@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#include "scan.hpp"
+#include "stats.hpp"
+
+static_assert(stdx::scan_stats_enabled);
+// Сборка со статистикой получает свои имена типов: шаблон без статистики из другой единицы трансляции с ней не смешать.
+static_assert(std::is_same_v<stdx::scan_pattern<int>, stdx::stats_on::scan_pattern<int>>);
+
+namespace {
+
+// Статистика формата из снимка; формат, ещё не встречавшийся в снимке, даёт нулевые счётчики.
+stdx::scan_stats stats_of(std::string_view format) {
+    for(auto& stats : stdx::scan_stats_snapshot()) {
+        if(stats.format == format) {
+            return stats;
+        }
+    }
+    return {};
+}
+
+std::uint64_t errors_of(const stdx::scan_stats& stats, stdx::details::scan_errc code) {
+    return stats.errors[static_cast<std::size_t>(code)];
+}
+
+}  // namespace
+
+// --- Scan Statistics Tests ---
+
+TEST(StatsTest, CountsCallsFailuresAndBytes) {
+    constexpr std::string_view format = "stats-scan id={%d}";
+    const auto before                 = stats_of(format);
+
+    EXPECT_TRUE(stdx::scan<int>("stats-scan id=1", format).has_value());
+    EXPECT_TRUE(stdx::scan<int>("stats-scan id=22", format).has_value());
+    EXPECT_FALSE(stdx::scan<int>("other", format).has_value());
+    EXPECT_FALSE(stdx::scan<int>("stats-scan id=x", format).has_value());
+
+    const auto after = stats_of(format);
+    EXPECT_EQ(after.calls - before.calls, 4u);
+    EXPECT_EQ(after.failures - before.failures, 2u);
+    EXPECT_EQ(after.bytes - before.bytes, 15u + 16u + 5u + 15u);
+    EXPECT_EQ(errors_of(after, stdx::details::scan_errc::literal_mismatch) -
+                  errors_of(before, stdx::details::scan_errc::literal_mismatch),
+              1u);
+    EXPECT_EQ(errors_of(after, stdx::details::scan_errc::invalid_integer) -
+                  errors_of(before, stdx::details::scan_errc::invalid_integer),
+              1u);
+}
+
+TEST(StatsTest, SameFormatTextSharesStatistics) {
+    const std::string first  = "stats-shared {%d}";
+    const std::string second = "stats-shared {%d}";
+    const auto before        = stats_of(first);
+
+    EXPECT_TRUE(stdx::scan<int>("stats-shared 1", first).has_value());
+    EXPECT_TRUE(stdx::scan<int>("stats-shared 2", second).has_value());
+    EXPECT_EQ(stats_of(first).calls - before.calls, 2u);
+}
+
+TEST(StatsTest, ReusedFormatBufferIsNotMisattributed) {
+    std::string format = "stats-reuse-a {%d}";
+    EXPECT_TRUE(stdx::scan<int>("stats-reuse-a 1", format).has_value());
+    format.replace(12, 1, "b");
+    EXPECT_TRUE(stdx::scan<int>("stats-reuse-b 1", format).has_value());
+
+    EXPECT_EQ(stats_of("stats-reuse-a {%d}").calls, 1u);
+    EXPECT_EQ(stats_of("stats-reuse-b {%d}").calls, 1u);
+}
+
+TEST(StatsTest, CompiledPatternAndScanFormat) {
+    auto pattern = stdx::scan_pattern<int, std::string_view>::compile("stats-pattern {%d} {%s}");
+    ASSERT_TRUE(pattern.has_value());
+    EXPECT_TRUE(pattern->scan("stats-pattern 1 a").has_value());
+    EXPECT_FALSE(pattern->scan("stats-pattern").has_value());
+
+    static constexpr stdx::scan_format<int> format {"stats-format {%d}"};
+    EXPECT_TRUE(format.scan("stats-format 5").has_value());
+
+    const auto compiled = stats_of("stats-pattern {%d} {%s}");
+    EXPECT_EQ(compiled.calls, 2u);
+    EXPECT_EQ(compiled.failures, 1u);
+    EXPECT_EQ(stats_of("stats-format {%d}").calls, 1u);
+}
+
+TEST(StatsTest, AggregatesAcrossThreads) {
+    constexpr std::string_view format = "stats-thread {%d}";
+    std::thread finished([&] {
+        for(int i = 0; i < 100; ++i) {
+            (void)stdx::scan<int>("stats-thread 1", format);
+        }
+    });
+    finished.join();
+
+    for(int i = 0; i < 50; ++i) {
+        (void)stdx::scan<int>("stats-thread 2", format);
+    }
+    // Итоги завершившегося потока сохраняются, а счётчики текущего читаются из его блока.
+    EXPECT_EQ(stats_of(format).calls, 150u);
+}
+
+TEST(StatsTest, PhaseTimesAreRecorded) {
+    constexpr std::string_view format = "stats-time {%d} {%f} {%s}";
+    for(int i = 0; i < 1000; ++i) {
+        (void)stdx::scan<int, double, std::string>("stats-time 12345 3.25 some-text-value", format);
+    }
+    const auto stats = stats_of(format);
+    EXPECT_EQ(stats.timed, (1000u + STDX_SCAN_STATS_SAMPLE - 1) / STDX_SCAN_STATS_SAMPLE);
+    EXPECT_GT(stats.match_ns + stats.convert_ns, 0u);
+}
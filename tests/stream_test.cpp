@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "stream.hpp"
+#include "test_helpers.hpp"
+
+using test_helpers::numbered_lines;
+
+static_assert(std::ranges::input_range<stdx::stream_scan<int>>);
+
+// --- Stream Scan Tests ---
+
+TEST(StreamScanTest, RecordsSplitAcrossChunks) {
+    const auto content = numbered_lines(200);
+    std::istringstream input {content};
+    auto lines = stdx::scan_stream<int, std::string>(input, "id={%d} name={%s}", 32);
+    ASSERT_TRUE(lines.has_value());
+    EXPECT_EQ(lines->capacity(), 32u);
+
+    int index = 0;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value()) << line.error().message();
+        EXPECT_EQ(std::get<0>(line->result), index * 7919);
+        EXPECT_EQ(std::get<1>(line->result), "user" + std::to_string(index));
+        ++index;
+    }
+    EXPECT_EQ(index, 200);
+}
+
+TEST(StreamScanTest, LastLineWithoutNewline) {
+    std::istringstream input {"10\n20\n30"};
+    auto lines = stdx::scan_stream<int>(input, "{%d}", 4);
+    ASSERT_TRUE(lines.has_value());
+
+    std::vector<int> values;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        values.push_back(std::get<0>(line->result));
+    }
+    EXPECT_EQ(values, (std::vector<int> {10, 20, 30}));
+}
+
+TEST(StreamScanTest, EmptyStream) {
+    std::istringstream input {""};
+    auto lines = stdx::scan_stream<int>(input, "{%d}");
+    ASSERT_TRUE(lines.has_value());
+    EXPECT_TRUE(lines->begin() == lines->end());
+}
+
+TEST(StreamScanTest, StringViewFieldsPointIntoBuffer) {
+    std::istringstream input {"alpha\nbeta\n"};
+    auto lines = stdx::scan_stream<std::string_view>(input, "{%s}", 8);
+    ASSERT_TRUE(lines.has_value());
+
+    std::vector<std::string> names;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        names.emplace_back(std::get<0>(line->result));
+    }
+    EXPECT_EQ(names, (std::vector<std::string> {"alpha", "beta"}));
+}
+
+TEST(StreamScanTest, ReadCallbackOneByteAtATime) {
+    const auto content = numbered_lines(50);
+    std::size_t position = 0;
+    auto lines           = stdx::scan_stream<int, std::string>(
+        [&](char* buffer, std::size_t size) -> std::ptrdiff_t {
+            if(position == content.size() || size == 0) {
+                return 0;
+            }
+            buffer[0] = content[position++];
+            return 1;
+        },
+        "id={%d} name={%s}", 32);
+    ASSERT_TRUE(lines.has_value());
+
+    int index = 0;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        EXPECT_EQ(std::get<0>(line->result), index * 7919);
+        ++index;
+    }
+    EXPECT_EQ(index, 50);
+}
+
+TEST(StreamScanTest, ReadFromPipe) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    const auto content = numbered_lines(1000);
+    std::thread writer([&] {
+        for(std::size_t written = 0; written < content.size();) {
+            const auto count = ::write(fds[1], content.data() + written, content.size() - written);
+            if(count <= 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(count);
+        }
+        ::close(fds[1]);
+    });
+
+    auto lines = stdx::scan_stream<int, std::string_view>(fds[0], "id={%d} name={%s}", 256);
+    ASSERT_TRUE(lines.has_value());
+    int index = 0;
+    for(const auto& line : lines.value()) {
+        ASSERT_TRUE(line.has_value());
+        EXPECT_EQ(std::get<0>(line->result), index * 7919);
+        ++index;
+    }
+    writer.join();
+    ::close(fds[0]);
+    EXPECT_EQ(index, 1000);
+}
+
+TEST(StreamScanTest, RecordTooLongIsReportedAndSkipped) {
+    std::istringstream input {"1\n" + std::string(100, '9') + "\n2\n"};
+    auto lines = stdx::scan_stream<int>(input, "{%d}", 8);
+    ASSERT_TRUE(lines.has_value());
+
+    auto it = lines->begin();
+    ASSERT_TRUE(it->has_value());
+    EXPECT_EQ(std::get<0>((*it)->result), 1);
+
+    ++it;
+    ASSERT_FALSE(it->has_value());
+    EXPECT_EQ(it->error().code, stdx::details::scan_errc::record_too_long);
+    EXPECT_EQ(it->error().message(), "Unexpected result. Record does not fit into the stream buffer.");
+
+    ++it;
+    ASSERT_TRUE(it->has_value());
+    EXPECT_EQ(std::get<0>((*it)->result), 2);
+
+    ++it;
+    EXPECT_TRUE(it == lines->end());
+}
+
+TEST(StreamScanTest, ReadErrorStopsIteration) {
+    bool failed = false;
+    auto lines  = stdx::scan_stream<int>(
+        [&](char* buffer, std::size_t) -> std::ptrdiff_t {
+            if(failed) {
+                return -1;
+            }
+            failed = true;
+            std::memcpy(buffer, "1\n2", 3);
+            return 3;
+        },
+        "{%d}");
+    ASSERT_TRUE(lines.has_value());
+
+    auto it = lines->begin();
+    ASSERT_TRUE(it->has_value());
+    EXPECT_EQ(std::get<0>((*it)->result), 1);
+
+    ++it;
+    ASSERT_FALSE(it->has_value());
+    EXPECT_EQ(it->error().code, stdx::details::scan_errc::stream_read_failed);
+
+    ++it;
+    EXPECT_TRUE(it == lines->end());
+}
+
+TEST(StreamScanTest, InvalidFormat) {
+    std::istringstream input {"1\n"};
+    auto lines = stdx::scan_stream<int>(input, "{%d} {%d}");
+    EXPECT_FALSE(lines.has_value());
+}
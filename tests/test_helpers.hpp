@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+// Генераторы входных данных, общие для нескольких тестовых файлов.
+namespace test_helpers {
+
+// Случайная строка из небольшого алфавита, чтобы совпадения и частичные совпадения встречались часто.
+inline std::string random_text(std::mt19937& rng, std::size_t size, std::string_view alphabet) {
+    std::string text(size, ' ');
+    for(auto& c : text) {
+        c = alphabet[rng() % alphabet.size()];
+    }
+    return text;
+}
+
+// Строки "id=<число> name=user<номер>\n": записи разной длины гарантированно пересекают границы маленьких кусков.
+inline std::string numbered_lines(int count) {
+    std::string content;
+    for(int i = 0; i < count; ++i) {
+        content += "id=" + std::to_string(i * 7919) + " name=user" + std::to_string(i) + "\n";
+    }
+    return content;
+}
+
+}  // namespace test_helpers